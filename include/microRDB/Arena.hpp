@@ -0,0 +1,56 @@
+// Arena.hpp
+
+#ifndef ARENA
+#define ARENA
+
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// bump allocator, everything in it is released at once when the arena is destroyed
+// objects are never destroyed individually, so they must be trivially destructible
+class Arena {
+private:
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char* next = nullptr;
+    size_t remaining = 0;
+    size_t nextBlockSize = 4096;
+
+    static constexpr size_t maxBlockSize = size_t(64) << 20;
+
+    void* allocate(size_t size, size_t alignment);
+
+public:
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // uninitialized storage for count trivial objects
+    template <typename T>
+    T* makeArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // copy of text that lives as long as the arena
+    std::string_view copy(std::string_view text);
+
+    size_t numBlocks() const { return blocks.size(); }
+};
+
+// process-wide string pool, equal strings share one stable std::string
+// used for identifiers and type names, which come from a small vocabulary
+// sharded by hash behind a per-thread cache, so parallel parsers rarely contend
+const std::string& intern(std::string_view text);
+
+#endif
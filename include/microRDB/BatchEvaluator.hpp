@@ -0,0 +1,161 @@
+// BatchEvaluator.hpp
+
+#ifndef BATCHEVALUATOR
+#define BATCHEVALUATOR
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "microRDB/Node.hpp"
+#include "microRDB/Table.hpp"
+#include "microRDB/Value.hpp"
+#include "microRDB/Visitor.hpp"
+
+// evaluates bound scalar expressions over a batch of rows at a time, every operator is one loop over the
+// selected rows instead of one visit per row, && and || only evaluate their right side where it decides the result
+class BatchEvaluator : public Visitor {
+public:
+    static constexpr size_t batchSize = 1024;
+
+    // one value per selected row, in the array of its type
+    struct Vector {
+        Value::Type type = Value::intType;
+        std::vector<int> ints;
+        std::vector<float> floats;
+        std::vector<uint8_t> bools;
+        std::vector<std::string_view> chars; // views into the rows, the tree or the parameters
+    };
+
+private:
+    const std::vector<Row>& rows;
+
+    // values of the $ parameters of the statement
+    const std::vector<Value>* parameters;
+
+    // rows the expression being visited is evaluated for, its values are left in result
+    const std::vector<uint32_t>* selection = nullptr;
+    Vector result;
+
+    Vector evaluateOn(const Node::Node* expr, const std::vector<uint32_t>& rowsSelected);
+    void broadcast(const Value& v);
+    void compare(const Node::Node* LHS, const Node::Node* RHS, Node::Operator op);
+    void arithmetic(const Node::Node* LHS, const Node::Node* RHS, Node::Operator op);
+    void logical(const Node::Node* LHS, const Node::Node* RHS, bool isAnd);
+
+public:
+    BatchEvaluator(const std::vector<Row>& rows, const std::vector<Value>* parameters = nullptr)
+        : rows(rows), parameters(parameters) {}
+
+    // values of expr for each row of selected, indexes into the rows
+    Vector evaluate(const Node::Node* expr, const std::vector<uint32_t>& selected);
+
+    // keep the rows of selected for which a bool expression holds, in order
+    void filter(const Node::Node* condition, std::vector<uint32_t>& selected);
+
+    // the k-th value of a vector
+    static Value valueAt(const Vector& vector, size_t k);
+
+    // visit script
+    void visit(const Node::Script* n) override;
+
+    // visit create
+    void visit(const Node::Create* n) override;
+
+    // visit name-type list
+    void visit(const Node::NameTypeList* n) override;
+
+    // visit name-type pair
+    void visit(const Node::NameTypePair* n) override;
+
+    // visit drop
+    void visit(const Node::Drop* n) override;
+
+    // visit analyze
+    void visit(const Node::Analyze* n) override;
+
+    // visit delete
+    void visit(const Node::Delete* n) override;
+
+    // visit filter
+    void visit(const Node::Filter* n) override;
+
+    // visit update
+    void visit(const Node::Update* n) override;
+
+    // visit assign list
+    void visit(const Node::AssignList* n) override;
+
+    // visit assign
+    void visit(const Node::Assign* n) override;
+
+    // visit insert
+    void visit(const Node::Insert* n) override;
+
+    // visit bulk insert
+    void visit(const Node::BulkInsert* n) override;
+
+    // visit load
+    void visit(const Node::Load* n) override;
+
+    // visit expression list
+    void visit(const Node::ExpressionList* n) override;
+
+    // visit or expression
+    void visit(const Node::OrExpression* n) override;
+
+    // visit and expression
+    void visit(const Node::AndExpression* n) override;
+
+    // visit equality expression
+    void visit(const Node::EqualityExpression* n) override;
+
+    // visit relational expression
+    void visit(const Node::RelationalExpression* n) override;
+
+    // visit additive expression
+    void visit(const Node::AdditiveExpression* n) override;
+
+    // visit multiplicative expression
+    void visit(const Node::MultiplicativeExpression* n) override;
+
+    // visit identifier
+    void visit(const Node::Identifier* n) override;
+
+    // visit int literal
+    void visit(const Node::IntLiteral* n) override;
+
+    // visit float literal
+    void visit(const Node::FloatLiteral* n) override;
+
+    // visit bool literal
+    void visit(const Node::BoolLiteral* n) override;
+
+    // visit chars literal
+    void visit(const Node::CharsLiteral* n) override;
+
+    // visit parameter
+    void visit(const Node::Parameter* n) override;
+
+    // visit select expression
+    void visit(const Node::SelectExpression* n) override;
+
+    // visit project expression
+    void visit(const Node::ProjectExpression* n) override;
+
+    // visit column list
+    void visit(const Node::ColumnList* n) override;
+
+    // visit union expression
+    void visit(const Node::UnionExpression* n) override;
+
+    // visit difference expression
+    void visit(const Node::DifferenceExpression* n) override;
+
+    // visit intersect expression
+    void visit(const Node::IntersectExpression* n) override;
+
+    // visit join expression
+    void visit(const Node::JoinExpression* n) override;
+};
+
+#endif
@@ -0,0 +1,164 @@
+// Binder.hpp
+
+#ifndef BINDER
+#define BINDER
+
+#include <functional>
+#include <string>
+#include "microRDB/Catalog.hpp"
+#include "microRDB/Node.hpp"
+#include "microRDB/Table.hpp"
+#include "microRDB/Visitor.hpp"
+
+// semantic analysis of one statement against the catalog as the statements before it left it
+// resolves column references to ordinals and records the result type of every scalar expression
+// on its node, so the executor neither looks columns up by name nor checks operand types per row
+class Binder : public Visitor {
+private:
+    const Catalog& catalog;
+
+    // values the $ parameters will have, only their types matter here
+    const std::vector<Value>* parameters;
+
+    // columns of the most recently bound relational expression
+    Table schema;
+
+    // columns scalar expressions may refer to, null outside of filters and assignments
+    const Table* rowSchema = nullptr;
+    bool bindingScalar = false;
+
+    // print the error and terminate
+    void semanticError(const std::string& message) const;
+
+    // the named table, terminating if there is none
+    const Table& lookupTable(const std::string& name) const;
+
+    // bind a relational expression, its columns are left in schema
+    void bindRelation(const Node::Node* expr);
+
+    // bind a scalar expression against rowSchema
+    const Node::Binding& bindScalar(const Node::Node* expr);
+
+    // bind a scalar expression that must be a bool
+    void bindCondition(const Node::Node* expr);
+
+    // a value of the expression's type can be stored in column
+    void checkStorable(const Node::Node* expr, const Column& column);
+
+    // rows of a maintained table only change through its definition
+    void checkWritable(const std::string& tableName);
+
+public:
+    Binder(const Catalog& catalog, const std::vector<Value>* parameters = nullptr)
+        : catalog(catalog), parameters(parameters) {}
+
+    // runs before an error terminates, so the statements ahead of this one can finish first
+    std::function<void()> beforeError;
+
+    // columns of the most recently bound relational expression
+    const Table& relationSchema() const { return schema; }
+
+    // visit script
+    void visit(const Node::Script* n) override;
+
+    // visit create
+    void visit(const Node::Create* n) override;
+
+    // visit name-type list
+    void visit(const Node::NameTypeList* n) override;
+
+    // visit name-type pair
+    void visit(const Node::NameTypePair* n) override;
+
+    // visit drop
+    void visit(const Node::Drop* n) override;
+
+    // visit analyze
+    void visit(const Node::Analyze* n) override;
+
+    // visit delete
+    void visit(const Node::Delete* n) override;
+
+    // visit filter
+    void visit(const Node::Filter* n) override;
+
+    // visit update
+    void visit(const Node::Update* n) override;
+
+    // visit assign list
+    void visit(const Node::AssignList* n) override;
+
+    // visit assign
+    void visit(const Node::Assign* n) override;
+
+    // visit insert
+    void visit(const Node::Insert* n) override;
+
+    // visit bulk insert
+    void visit(const Node::BulkInsert* n) override;
+
+    // visit load
+    void visit(const Node::Load* n) override;
+
+    // visit expression list
+    void visit(const Node::ExpressionList* n) override;
+
+    // visit or expression
+    void visit(const Node::OrExpression* n) override;
+
+    // visit and expression
+    void visit(const Node::AndExpression* n) override;
+
+    // visit equality expression
+    void visit(const Node::EqualityExpression* n) override;
+
+    // visit relational expression
+    void visit(const Node::RelationalExpression* n) override;
+
+    // visit additive expression
+    void visit(const Node::AdditiveExpression* n) override;
+
+    // visit multiplicative expression
+    void visit(const Node::MultiplicativeExpression* n) override;
+
+    // visit identifier
+    void visit(const Node::Identifier* n) override;
+
+    // visit int literal
+    void visit(const Node::IntLiteral* n) override;
+
+    // visit float literal
+    void visit(const Node::FloatLiteral* n) override;
+
+    // visit bool literal
+    void visit(const Node::BoolLiteral* n) override;
+
+    // visit chars literal
+    void visit(const Node::CharsLiteral* n) override;
+
+    // visit parameter
+    void visit(const Node::Parameter* n) override;
+
+    // visit select expression
+    void visit(const Node::SelectExpression* n) override;
+
+    // visit project expression
+    void visit(const Node::ProjectExpression* n) override;
+
+    // visit column list
+    void visit(const Node::ColumnList* n) override;
+
+    // visit union expression
+    void visit(const Node::UnionExpression* n) override;
+
+    // visit difference expression
+    void visit(const Node::DifferenceExpression* n) override;
+
+    // visit intersect expression
+    void visit(const Node::IntersectExpression* n) override;
+
+    // visit join expression
+    void visit(const Node::JoinExpression* n) override;
+};
+
+#endif
@@ -0,0 +1,26 @@
+// BloomFilter.hpp
+
+#ifndef BLOOMFILTER
+#define BLOOMFILTER
+
+#include <cstdint>
+#include <vector>
+
+// cache-line blocked Bloom filter, every key sets one bit in each word of a single 64 byte block
+class BloomFilter {
+private:
+    struct alignas(64) Block {
+        uint64_t words[8] = {};
+    };
+    std::vector<Block> blocks;
+
+    const Block& blockOf(uint64_t hash) const;
+
+public:
+    BloomFilter(size_t expectedKeys, size_t bitsPerKey = 16);
+
+    void add(uint64_t hash);
+    bool mayContain(uint64_t hash) const;
+};
+
+#endif
@@ -0,0 +1,45 @@
+// BulkLoader.hpp
+
+#ifndef BULKLOADER
+#define BULKLOADER
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "microRDB/Table.hpp"
+#include "microRDB/ThreadPool.hpp"
+
+// loads rows for a table's columns from a file, converting every field per the schema
+// CSV: one record per line, fields separated by commas, chars fields may be wrapped in quotes
+//      quoted fields may contain commas but not quotes or newlines, a header naming the columns is skipped
+// binary (.bin): fixed width records, native int and float, one byte bools, chars zero padded to their width
+// the memory mapped file is split into chunks that are parsed on all threads
+class BulkLoader {
+private:
+    ThreadPool& pool;
+    size_t chunkSize;
+
+    // first malformed field of a chunk, reported by file offset once every chunk is done
+    struct LoadError {
+        size_t offset = std::string_view::npos;
+        std::string message;
+    };
+
+    void loadCsv(std::string_view text, const std::vector<Column>& columns, std::vector<Row>& rows) const;
+    void loadBinary(std::string_view text, const std::vector<Column>& columns, std::vector<Row>& rows) const;
+
+    // parse the records of a CSV chunk, stopping at the first malformed field
+    void parseCsvChunk(std::string_view text, size_t begin, size_t end, const std::vector<Column>& columns,
+                       std::vector<Row>& rows, LoadError& error) const;
+
+public:
+    static constexpr size_t defaultChunkSize = 1 << 22;
+
+    explicit BulkLoader(ThreadPool& pool, size_t chunkSize = defaultChunkSize)
+        : pool(pool), chunkSize(chunkSize) {}
+
+    // rows in file order, terminates on an unreadable file or a malformed field
+    std::vector<Row> load(const std::string& path, const std::vector<Column>& columns) const;
+};
+
+#endif
@@ -0,0 +1,163 @@
+// CardinalityEstimator.hpp
+
+#ifndef CARDINALITYESTIMATOR
+#define CARDINALITYESTIMATOR
+
+#include <string>
+#include <vector>
+#include "microRDB/Catalog.hpp"
+#include "microRDB/Node.hpp"
+#include "microRDB/Visitor.hpp"
+
+// estimated shape of a relation
+struct RelationEstimate {
+    double rows = 0.0;
+    std::vector<std::string> columns;
+    std::vector<double> distinct;
+    std::vector<const ColumnStatistics*> statistics; // base column statistics, null when unknown
+
+    int columnIndex(const std::string& name) const;
+};
+
+// estimates relation cardinalities and filter selectivities from catalog statistics
+class CardinalityEstimator : public Visitor {
+private:
+    const Catalog& catalog;
+
+    RelationEstimate estimate;
+
+    // scalar operand of the most recently visited expression
+    enum OperandKind {
+        columnOperand,
+        literalOperand,
+        otherOperand,
+    };
+    OperandKind operandKind = otherOperand;
+    int operandColumn = -1;
+    double operandLiteral = 0.0;
+    bool operandIsNumeric = false;
+    double selectivity = 1.0;
+
+    const RelationEstimate* input = nullptr;
+    bool evaluatingScalar = false;
+
+    void visitScalar(const Node::Node* expr);
+    double comparisonSelectivity(const Node::Node* LHS, const Node::Node* RHS, Node::Operator op);
+
+public:
+    CardinalityEstimator(const Catalog& catalog)
+        : catalog(catalog) {}
+
+    // estimated output of a relational expression
+    RelationEstimate estimateRelation(const Node::Node* expr);
+
+    // estimated fraction of input rows satisfying a predicate
+    double estimateSelectivity(const Node::Node* predicate, const RelationEstimate& input);
+
+    // estimated output of joining two estimated relations
+    static RelationEstimate estimateJoin(const RelationEstimate& left, const RelationEstimate& right);
+
+    // visit script
+    void visit(const Node::Script* n) override;
+
+    // visit create
+    void visit(const Node::Create* n) override;
+
+    // visit name-type list
+    void visit(const Node::NameTypeList* n) override;
+
+    // visit name-type pair
+    void visit(const Node::NameTypePair* n) override;
+
+    // visit drop
+    void visit(const Node::Drop* n) override;
+
+    // visit analyze
+    void visit(const Node::Analyze* n) override;
+
+    // visit delete
+    void visit(const Node::Delete* n) override;
+
+    // visit filter
+    void visit(const Node::Filter* n) override;
+
+    // visit update
+    void visit(const Node::Update* n) override;
+
+    // visit assign list
+    void visit(const Node::AssignList* n) override;
+
+    // visit assign
+    void visit(const Node::Assign* n) override;
+
+    // visit insert
+    void visit(const Node::Insert* n) override;
+
+    // visit bulk insert
+    void visit(const Node::BulkInsert* n) override;
+
+    // visit load
+    void visit(const Node::Load* n) override;
+
+    // visit expression list
+    void visit(const Node::ExpressionList* n) override;
+
+    // visit or expression
+    void visit(const Node::OrExpression* n) override;
+
+    // visit and expression
+    void visit(const Node::AndExpression* n) override;
+
+    // visit equality expression
+    void visit(const Node::EqualityExpression* n) override;
+
+    // visit relational expression
+    void visit(const Node::RelationalExpression* n) override;
+
+    // visit additive expression
+    void visit(const Node::AdditiveExpression* n) override;
+
+    // visit multiplicative expression
+    void visit(const Node::MultiplicativeExpression* n) override;
+
+    // visit identifier
+    void visit(const Node::Identifier* n) override;
+
+    // visit int literal
+    void visit(const Node::IntLiteral* n) override;
+
+    // visit float literal
+    void visit(const Node::FloatLiteral* n) override;
+
+    // visit bool literal
+    void visit(const Node::BoolLiteral* n) override;
+
+    // visit chars literal
+    void visit(const Node::CharsLiteral* n) override;
+
+    // visit parameter
+    void visit(const Node::Parameter* n) override;
+
+    // visit select expression
+    void visit(const Node::SelectExpression* n) override;
+
+    // visit project expression
+    void visit(const Node::ProjectExpression* n) override;
+
+    // visit column list
+    void visit(const Node::ColumnList* n) override;
+
+    // visit union expression
+    void visit(const Node::UnionExpression* n) override;
+
+    // visit difference expression
+    void visit(const Node::DifferenceExpression* n) override;
+
+    // visit intersect expression
+    void visit(const Node::IntersectExpression* n) override;
+
+    // visit join expression
+    void visit(const Node::JoinExpression* n) override;
+};
+
+#endif
@@ -0,0 +1,223 @@
+// Catalog.hpp
+
+#ifndef CATALOG
+#define CATALOG
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "microRDB/Compactor.hpp"
+#include "microRDB/IncrementalView.hpp"
+#include "microRDB/LsmTree.hpp"
+#include "microRDB/Statistics.hpp"
+#include "microRDB/Table.hpp"
+#include "microRDB/VersionCollector.hpp"
+
+// tables by name, with their statistics and the views defined over them
+// snapshots read versions of the rows published where statements end, statistics are shared and copied on the next write
+class Catalog {
+private:
+    std::unordered_map<std::string, std::shared_ptr<Table>> tables;
+    std::unordered_map<std::string, std::shared_ptr<TableStatistics>> statistics;
+    size_t version = 0;
+
+    // per table, drawn from one counter so a recreated table never reuses an old version
+    // statements on different tables touch them concurrently, only create adds a table's entry
+    std::unordered_map<std::string, uint64_t> dataVersions;
+    std::atomic<uint64_t> nextDataVersion{1};
+
+    // tables kept equal to their definitions, in creation order so a view is maintained before views over it
+    std::vector<std::pair<std::string, std::unique_ptr<IncrementalView>>> views;
+
+    // tables whose rows are not computed yet, by the select and project chain that defines them
+    std::unordered_map<std::string, std::shared_ptr<const IncrementalView>> deferred;
+
+    // tables whose rows are kept in a log-structured merge tree, their catalog rows are only filled while a statement reads them
+    std::unordered_map<std::string, std::shared_ptr<LsmTree>> lsmTrees;
+
+    // held for the whole of each statement, a snapshot is taken between two statements
+    std::mutex statementMutex;
+
+    // frees the versions writes replaced once the snapshots reading them are gone
+    // created by the first snapshot and shared with every snapshot, only they share versions
+    std::shared_ptr<VersionCollector> collector;
+
+    // rows the statements between two publishes appended, erased or updated in place
+    struct RowChanges {
+        std::vector<Row> appended;
+        std::vector<size_t> erased;
+        std::vector<std::pair<size_t, Row>> updated;
+        std::shared_ptr<const RowChanges> previous;
+    };
+
+    // a table's rows as snapshots see them: a copy taken at some publish, with the changes of every publish since on top
+    // shared by every published state it did not change in, LSM tables are a view of their tree instead
+    struct TableVersion {
+        std::shared_ptr<const Table> base;
+        std::shared_ptr<const RowChanges> changes; // newest first
+        size_t numChanged = 0; // rows in changes, the table is copied again once they outgrow a fraction of it
+        std::shared_ptr<LsmTree> tree;
+        LsmTree::View view;
+
+        // base with the changes applied, made by the first snapshot reading it and the next version's base
+        mutable std::mutex mutex;
+        mutable std::shared_ptr<const Table> rows;
+
+        std::shared_ptr<const Table> materialize() const;
+    };
+
+    // what the statements since the last publish did to a table's rows, only kept while a state is published
+    // statements on different tables note their writes concurrently, only create adds a table's entry
+    struct Writes {
+        size_t numRows = 0; // rows at the last publish, the ones after it were appended
+        bool changed = false;
+        bool rewritten = false; // rows were replaced or moved, the next publish copies the table
+        std::vector<size_t> erased;
+        std::vector<size_t> updated;
+    };
+    std::unordered_map<std::string, Writes> writes;
+    bool tracksWrites = false;
+
+    // the next version is copied from the table once the changes on its base reach this fraction of its rows
+    static constexpr double rebaseFraction = 0.25;
+
+    // what a snapshot reads, tables as versions of their rows
+    struct State {
+        std::unordered_map<std::string, std::shared_ptr<const TableVersion>> tables;
+        std::unordered_map<std::string, std::shared_ptr<TableStatistics>> statistics;
+        size_t version = 0;
+        std::unordered_map<std::string, uint64_t> dataVersions;
+        uint64_t nextDataVersion = 0;
+        std::unordered_map<std::string, std::shared_ptr<const IncrementalView>> deferred;
+    };
+
+    // the state the last finished statement or transaction left, kept while snapshot readers are open
+    std::shared_ptr<const State> published;
+    std::mutex publishedMutex;
+    std::atomic<size_t> numSnapshotReaders{0};
+
+    // the state as it is, under the statement lock
+    // tables no statement wrote since previous keep its versions, written ones add their changes to them
+    std::shared_ptr<const State> nextState(const State* previous);
+
+    // a snapshot's tables, given their rows when a statement first reads them, empty for the catalog itself
+    std::unordered_map<std::string, std::shared_ptr<const TableVersion>> versions;
+
+    // a table is compacted once this fraction of one of its segments is deleted, from that segment on
+    static constexpr double compactionThreshold = 0.25;
+
+    // live rows moved per compaction slice, the statement lock is held for one slice
+    static constexpr size_t compactionSliceRows = DeletionBitmap::segmentSize;
+
+    // the table the compactor is part way through and the row it resumes at
+    std::string compacting;
+    size_t compactingFrom = 0;
+
+    // created once by the first delete, which concurrent statements of a script may race to,
+    // destroyed before the tables it compacts
+    std::once_flag compactorCreated;
+    std::unique_ptr<Compactor> compactor;
+
+    // one slice of compaction under the statement lock, true while work is left
+    bool compactSlice();
+
+    // statistics a snapshot still reads are replaced by a copy before they are written
+    TableStatistics& writable(std::shared_ptr<TableStatistics>& version);
+
+    // the table whose rows a deferred copy of a table shares, name itself otherwise
+    const std::string& resolve(const std::string& name) const;
+
+public:
+    Catalog() = default;
+    ~Catalog();
+    Catalog(const Catalog&) = delete;
+    Catalog& operator=(const Catalog&) = delete;
+
+    bool contains(const std::string& name) const;
+
+    // lookups terminate on an unknown table name
+    const Table& table(const std::string& name) const;
+    const TableStatistics& tableStatistics(const std::string& name) const;
+
+    // for statements that change a table's rows in any way, the next publish copies the table for snapshots
+    Table& writableTable(const std::string& name);
+    TableStatistics& writableStatistics(const std::string& name);
+
+    // for statements that only append rows and erase or update the rows they note,
+    // the next publish hands snapshots just those rows
+    Table& appendableTable(const std::string& name);
+    void noteErased(const std::string& name, const std::vector<uint32_t>& rows);
+    void noteUpdated(const std::string& name, const std::vector<uint32_t>& rows);
+
+    void create(const std::string& name, Table table);
+    void drop(const std::string& name);
+    void analyze(const std::string& name);
+
+    // changes whenever a table is created or dropped, bound statements are stale once it moves
+    size_t schemaVersion() const { return version; }
+
+    // changes whenever a table's rows change, 0 for a table that does not exist
+    uint64_t dataVersion(const std::string& name) const;
+
+    // record that a table's rows changed
+    void touch(const std::string& name);
+
+    // every data version below it is visible, a snapshot keeps the timestamp it was taken at
+    uint64_t timestamp() const { return nextDataVersion; }
+
+    // a consistent copy of every table as the last finished statement or transaction left it, for reads on other threads
+    // shares row versions and statistics instead of copying them, maintained tables are plain tables in it
+    // waits for the running statement, and copies every table, unless a snapshot reader is open
+    std::unique_ptr<Catalog> snapshot();
+
+    // while a snapshot reader is open, every statement or transaction publishes the state it leaves, so snapshots
+    // never wait for writers, a publish keeps the rows each statement appended, erased or updated, not whole tables
+    // opening waits for the running statement and copies every table once
+    void openSnapshotReader();
+    void closeSnapshotReader();
+
+    // called by the executor under the statement lock, where a statement or transaction ends
+    void publish();
+
+    // held by the executor while a statement runs
+    std::unique_lock<std::mutex> lockStatement() { return std::unique_lock<std::mutex>(statementMutex); }
+
+    // remove a table's deleted rows in the background, called after a delete left some in place
+    // no table is compacted while a state is published for snapshot readers, until the next delete after that
+    void compactLater();
+
+    // replaced statistics and published states that snapshots still hold
+    size_t numRetiredVersions() const { return collector ? collector->numRetired() : 0; }
+
+    // keep an existing table equal to a view's definition from now on, dropping the table drops the view
+    void maintain(const std::string& name, std::unique_ptr<IncrementalView> view);
+    bool isMaintained(const std::string& name) const;
+    IncrementalView& maintainedView(const std::string& name);
+
+    // maintained tables whose definitions read a table
+    std::vector<std::string> maintainedReaders(const std::string& name) const;
+
+    // leave an existing table's rows to be computed from a select and project chain when a statement first reads it
+    // until then a plain copy of a table reads the rows of the table it copies, so creating either is O(1)
+    void defer(const std::string& name, std::unique_ptr<IncrementalView> definition);
+    bool isDeferred(const std::string& name) const;
+    const IncrementalView& deferredDefinition(const std::string& name) const;
+
+    // deferred tables whose definitions read a table
+    std::vector<std::string> deferredReaders(const std::string& name) const;
+
+    // give a deferred table its rows
+    void materialize(const std::string& name, std::vector<Row> rows);
+
+    // keep an existing, empty table's rows in an LSM tree from now on, dropping the table removes the tree's files
+    void storeInLsm(const std::string& name, std::shared_ptr<LsmTree> tree);
+    bool isLsm(const std::string& name) const;
+    LsmTree& lsmTree(const std::string& name);
+};
+
+#endif
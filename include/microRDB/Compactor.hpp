@@ -0,0 +1,38 @@
+// Compactor.hpp
+
+#ifndef COMPACTOR
+#define COMPACTOR
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// background compactor that removes deleted rows from tables one bounded slice at a time
+// slices are spaced interval apart, so statements waiting for the catalog are never held up by more than one slice
+class Compactor {
+private:
+    std::function<bool()> slice; // runs one slice, true while work is left
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool pending = false;
+    bool stopping = false;
+    std::thread thread;
+
+    static constexpr std::chrono::milliseconds interval{10};
+
+    void compactLoop();
+
+public:
+    explicit Compactor(std::function<bool()> slice);
+    ~Compactor();
+
+    Compactor(const Compactor&) = delete;
+    Compactor& operator=(const Compactor&) = delete;
+
+    // rows were deleted, run slices until none is left worth compacting
+    void notify();
+};
+
+#endif
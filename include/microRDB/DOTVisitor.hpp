@@ -30,6 +30,9 @@ public:
 
     // visit drop
     void visit(const Node::Drop* n) override;
+
+    // visit analyze
+    void visit(const Node::Analyze* n) override;
     
     // visit delete
     void visit(const Node::Delete* n) override;
@@ -49,6 +52,12 @@ public:
     // visit insert
     void visit(const Node::Insert* n) override;
 
+    // visit bulk insert
+    void visit(const Node::BulkInsert* n) override;
+
+    // visit load
+    void visit(const Node::Load* n) override;
+
     // visit expression list
     void visit(const Node::ExpressionList* n) override;
 
@@ -85,6 +94,9 @@ public:
     // visit chars literal
     void visit(const Node::CharsLiteral* n) override;
 
+    // visit parameter
+    void visit(const Node::Parameter* n) override;
+
     // visit select expression
     void visit(const Node::SelectExpression* n) override;
 
@@ -0,0 +1,50 @@
+// DeletionBitmap.hpp
+
+#ifndef DELETIONBITMAP
+#define DELETIONBITMAP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// rows a delete removed from a table but left in place, one bit per row
+// deleted rows are counted per segment, so scans skip fully deleted segments and the compactor finds the ones worth rewriting
+class DeletionBitmap {
+public:
+    static constexpr size_t segmentSize = 1 << 16;
+
+private:
+    std::vector<uint64_t> words; // only as long as the last deleted row needs
+    std::vector<size_t> segmentCounts;
+    size_t total = 0;
+
+    size_t skipDeleted(size_t row) const;
+
+public:
+    bool empty() const { return total == 0; }
+    size_t count() const { return total; }
+
+    // deleted rows among the segmentSize rows from segment * segmentSize
+    size_t countIn(size_t segment) const { return segment < segmentCounts.size() ? segmentCounts[segment] : 0; }
+
+    bool contains(size_t row) const {
+        size_t w = row / 64;
+        return w < words.size() && ((words[w] >> (row % 64)) & 1);
+    }
+
+    void insert(size_t row);
+    void erase(size_t row);
+
+    // the first row at or after row that is not deleted, rows past the last deleted one are all live
+    size_t nextLive(size_t row) const {
+        return row / 64 < words.size() ? skipDeleted(row) : row;
+    }
+
+    // the first deleted row at or after row, end if there is none before end
+    size_t nextDeleted(size_t row, size_t end) const;
+
+    // forget deleted rows at or after numRows, for a table cut to numRows rows
+    void truncate(size_t numRows);
+};
+
+#endif
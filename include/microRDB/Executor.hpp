@@ -0,0 +1,261 @@
+// Executor.hpp
+
+#ifndef EXECUTOR
+#define EXECUTOR
+
+#include <string>
+#include <vector>
+#include "microRDB/Catalog.hpp"
+#include "microRDB/JoinOrderer.hpp"
+#include "microRDB/Pipeline.hpp"
+#include "microRDB/ResultCache.hpp"
+#include "microRDB/Table.hpp"
+#include "microRDB/ThreadPool.hpp"
+#include "microRDB/Value.hpp"
+#include "microRDB/Visitor.hpp"
+#include "microRDB/WriteAheadLog.hpp"
+
+struct ExecutionOptions {
+    bool explain = false; // print the chosen join order of every ^ chain
+    bool stats = false; // print per-operator execution statistics
+    size_t threads = 0; // worker threads for morsel-driven operators, 0 for one per hardware thread
+    size_t morselSize = 100000; // rows per morsel
+    size_t resultCacheSize = 0; // read-only query results kept for reuse, 0 to disable
+    bool deferCreates = true; // compute tables created from select and project chains when first read
+    std::string walPath; // log every change here and replay the log on start, empty to disable
+    bool unloggedLoads = false; // loads bypass the log, a replay does not bring their rows back
+    bool scriptTransactions = false; // run each script as one transaction with a single log flush
+    bool parallelStatements = false; // run statements of a script on disjoint tables at the same time
+    std::string lsmPath; // keep tables created from a name-type list in LSM trees in this directory, empty to keep them in memory
+};
+
+// tree-walking executor over an in-memory catalog
+// relational nodes leave their result in relation, scalar nodes leave theirs in value
+class Executor : public Visitor {
+private:
+    Catalog& catalog;
+    ExecutionOptions options;
+    std::unique_ptr<ThreadPool> pool; // created on first parallel operator
+    ThreadPool* scriptPool = nullptr; // used instead, by a statement running beside others of its script
+    std::unique_ptr<ResultCache> resultCache; // created on first cacheable query
+    std::unique_ptr<WriteAheadLog> log; // opened after the log's committed statements are replayed
+
+    // held from the start of a transaction to its commit, statements inside it do not lock on their own
+    std::unique_lock<std::mutex> transactionLock;
+
+    // rebuild the catalog from the committed statements of the log
+    void recover();
+
+    // a statement that only reads and changes tables no view or deferred table depends on
+    bool isConcurrent(const Node::Node* statement) const;
+
+    // run bound concurrent statements level by level of the DAG of their table conflicts
+    // results print and redo records are logged in script order
+    void executeConcurrently(const std::vector<const Node::Node*>& statements);
+
+    // append the statement's redo record if the log replays it
+    void logStatement(const Node::Node* statement);
+
+    // redo records of the last load, its rows as inserts since the file may change before a replay
+    // kept by an executor whose own log or whose script's log records loads
+    bool recordsLoads = false;
+    std::vector<std::string> loadRecords;
+
+    // print the result of a bare select expression
+    void printRelation();
+
+    ThreadPool& threadPool();
+    size_t morselCount(size_t rows) const;
+
+    Table relation;
+    bool producedRelation = false;
+
+    Value value;
+    Row values;
+
+    // values of the $ parameters of the statement being executed
+    const std::vector<Value>* parameters = nullptr;
+
+    // row context for column references, null outside of filters
+    const Table* rowTable = nullptr;
+    const Row* row = nullptr;
+    bool evaluatingScalar = false;
+
+    // evaluate a scalar expression against the current row context
+    Value evaluate(const Node::Node* expr);
+
+    // evaluate a boolean expression, terminating on any other type
+    bool evaluateCondition(const Node::Node* expr);
+
+    // coerce a value to a column's type for storage
+    Value coerce(const Value& v, const Column& column);
+
+    // leaves of a ^ chain, base tables are scanned lazily so runtime filters can reach them
+    struct JoinChain {
+        std::vector<Table> leaves; // evaluated inputs, columns only for base tables
+        std::vector<const Table*> baseTables; // null for evaluated inputs
+        std::vector<std::string> names;
+    };
+
+    // compile a relational expression into pipeline, running pipeline breakers along the way
+    void compilePipeline(const Node::Node* n, Pipeline& pipeline);
+
+    // reorder a ^ chain, its probe spine continues pipeline
+    void compileJoinChain(const Node::JoinExpression* n, Pipeline& pipeline);
+
+    // build sides run as their own pipelines, runtime filters are pushed toward the scans
+    void compileJoinPlan(const JoinPlan* plan, JoinChain& chain, const std::vector<RuntimeFilter*>& filters, Pipeline& pipeline);
+
+    struct MorselState;
+
+    // run a pipeline's single fused loop over its source, in parallel morsels
+    Table runPipeline(Pipeline& pipeline);
+
+    // push a row through the steps of a pipeline starting at step s
+    void push(const Pipeline& pipeline, size_t s, const Row& current, MorselState& state);
+
+    // run a read-only query, or take its result from the result cache
+    void executeCached(const Node::Node* query);
+
+    // evaluates the select predicates of maintained tables
+    IncrementalView::Condition viewCondition();
+
+    // bring the maintained tables reading a table up to date with a change to its rows
+    void maintainViews(const std::string& tableName, const ZSet& change);
+
+    // compute the deferred tables a statement reads, and those over a table it changes while they still see its old rows
+    void materializeDeferred(const Node::Node* statement);
+    void materialize(const std::string& tableName);
+    std::vector<Row> evaluateDeferred(const DeltaNode& plan);
+
+    // fill in the rows of the LSM tables a statement reads, only those a point lookup can match when it filters on the key,
+    // every row of the tree for any other statement
+    std::vector<std::string> loadLsmTables(const Node::Node* statement);
+
+    // hand rows a statement appended to an LSM table to its tree, write back the rows it deleted or updated,
+    // and empty the loaded tables
+    void storeLsmTables(const Node::Node* statement, const std::vector<std::string>& loaded);
+
+    // tree ids of the loaded rows of the LSM table an update or delete changes, and the rows an update wrote
+    std::vector<LsmTree::RowId> lsmRowIds;
+    std::vector<uint32_t> lsmUpdatedRows;
+
+public:
+    Executor(Catalog& catalog, const ExecutionOptions& options = ExecutionOptions());
+
+    // run one statement the Binder has bound, with the values of its $ parameters
+    // bare select expressions print their result
+    void execute(const Node::Node* statement, const std::vector<Value>* parameterValues = nullptr);
+
+    // with scriptTransactions, start a transaction unless one is open, true if it did
+    // snapshots see none of its statements until commit, and the log flushes once for all of them
+    bool beginTransaction();
+    void commit();
+
+    // a statement that only reads tables, a bare relational expression
+    static bool isQuery(const Node::Node* statement);
+
+    // visit script
+    void visit(const Node::Script* n) override;
+
+    // visit create
+    void visit(const Node::Create* n) override;
+
+    // visit name-type list
+    void visit(const Node::NameTypeList* n) override;
+
+    // visit name-type pair
+    void visit(const Node::NameTypePair* n) override;
+
+    // visit drop
+    void visit(const Node::Drop* n) override;
+
+    // visit analyze
+    void visit(const Node::Analyze* n) override;
+
+    // visit delete
+    void visit(const Node::Delete* n) override;
+
+    // visit filter
+    void visit(const Node::Filter* n) override;
+
+    // visit update
+    void visit(const Node::Update* n) override;
+
+    // visit assign list
+    void visit(const Node::AssignList* n) override;
+
+    // visit assign
+    void visit(const Node::Assign* n) override;
+
+    // visit insert
+    void visit(const Node::Insert* n) override;
+
+    // visit bulk insert
+    void visit(const Node::BulkInsert* n) override;
+
+    // visit load
+    void visit(const Node::Load* n) override;
+
+    // visit expression list
+    void visit(const Node::ExpressionList* n) override;
+
+    // visit or expression
+    void visit(const Node::OrExpression* n) override;
+
+    // visit and expression
+    void visit(const Node::AndExpression* n) override;
+
+    // visit equality expression
+    void visit(const Node::EqualityExpression* n) override;
+
+    // visit relational expression
+    void visit(const Node::RelationalExpression* n) override;
+
+    // visit additive expression
+    void visit(const Node::AdditiveExpression* n) override;
+
+    // visit multiplicative expression
+    void visit(const Node::MultiplicativeExpression* n) override;
+
+    // visit identifier
+    void visit(const Node::Identifier* n) override;
+
+    // visit int literal
+    void visit(const Node::IntLiteral* n) override;
+
+    // visit float literal
+    void visit(const Node::FloatLiteral* n) override;
+
+    // visit bool literal
+    void visit(const Node::BoolLiteral* n) override;
+
+    // visit chars literal
+    void visit(const Node::CharsLiteral* n) override;
+
+    // visit parameter
+    void visit(const Node::Parameter* n) override;
+
+    // visit select expression
+    void visit(const Node::SelectExpression* n) override;
+
+    // visit project expression
+    void visit(const Node::ProjectExpression* n) override;
+
+    // visit column list
+    void visit(const Node::ColumnList* n) override;
+
+    // visit union expression
+    void visit(const Node::UnionExpression* n) override;
+
+    // visit difference expression
+    void visit(const Node::DifferenceExpression* n) override;
+
+    // visit intersect expression
+    void visit(const Node::IntersectExpression* n) override;
+
+    // visit join expression
+    void visit(const Node::JoinExpression* n) override;
+};
+
+#endif
@@ -0,0 +1,117 @@
+// FlatAst.hpp
+
+#ifndef FLATAST
+#define FLATAST
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "microRDB/Arena.hpp"
+#include "microRDB/Node.hpp"
+
+// one node of a FlatAst, children are referred to by index instead of by pointer
+struct FlatNode {
+    enum Kind : uint8_t {
+        script,
+        create,
+        nameTypeList,
+        nameTypePair,
+        drop,
+        analyze,
+        deleteStatement,
+        filter,
+        update,
+        assignList,
+        assign,
+        insert,
+        expressionList,
+        orExpression,
+        andExpression,
+        equalityExpression,
+        relationalExpression,
+        additiveExpression,
+        multiplicativeExpression,
+        identifier,
+        intLiteral,
+        floatLiteral,
+        boolLiteral,
+        charsLiteral,
+        selectExpression,
+        projectExpression,
+        columnList,
+        unionExpression,
+        differenceExpression,
+        intersectExpression,
+        joinExpression,
+        load,
+        parameter,
+    };
+
+    Kind kind;
+    Node::Operator op = Node::opEquals;
+    uint32_t end = 0; // one past the last node of this subtree
+    uint32_t firstChild = 0; // into FlatAst::children
+    uint32_t numChildren = 0;
+    uint32_t text = 0; // into FlatAst::strings, name-type pairs use three in a row, loads two
+    union {
+        int intValue; // also the index of a parameter
+        float floatValue;
+        bool boolValue; // also whether a create is maintained
+    };
+
+    FlatNode(Kind kind)
+        : kind(kind), intValue(0) {}
+};
+
+// contiguous encoding of a tree, laid out in preorder so every subtree is a contiguous range of nodes
+// passes switch on FlatNode::kind instead of double dispatching through a Visitor
+class FlatAst {
+private:
+    // copies of chars literals, so the flat form does not depend on the tree it was built from
+    std::unique_ptr<Arena> textArena;
+
+    void writeDot(std::ostream& out, uint32_t i) const;
+
+public:
+    std::vector<FlatNode> nodes; // nodes[0] is the script
+    std::vector<uint32_t> children;
+    std::vector<std::string_view> strings;
+
+    // child indices of a node
+    struct ChildRange {
+        const uint32_t* first;
+        const uint32_t* last;
+
+        const uint32_t* begin() const { return first; }
+        const uint32_t* end() const { return last; }
+        size_t size() const { return last - first; }
+        uint32_t operator[](size_t k) const { return first[k]; }
+    };
+
+    static FlatAst build(const Node::Script* script);
+
+    ChildRange childrenOf(uint32_t i) const {
+        const uint32_t* first = children.data() + nodes[i].firstChild;
+        return ChildRange{first, first + nodes[i].numChildren};
+    }
+
+    std::string_view text(uint32_t i, uint32_t k = 0) const {
+        return strings[nodes[i].text + k];
+    }
+
+    // f(index, node) over the subtree rooted at i in preorder, a linear scan of nodes
+    template <typename F>
+    void preorder(uint32_t i, F&& f) const {
+        for (uint32_t j = i; j < nodes[i].end; ++j) {
+            f(j, nodes[j]);
+        }
+    }
+
+    // same file DOTVisitor writes for the tree this was built from
+    void writeDot(const std::string& fileName) const;
+};
+
+#endif
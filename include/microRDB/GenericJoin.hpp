@@ -0,0 +1,43 @@
+// GenericJoin.hpp
+
+#ifndef GENERICJOIN
+#define GENERICJOIN
+
+#include <string>
+#include <vector>
+#include "microRDB/Table.hpp"
+
+// worst-case optimal multi-way natural join (leapfrog triejoin over sorted inputs)
+// binds one column at a time across all inputs, so no intermediate result outgrows the output
+class GenericJoin {
+private:
+    // input as a sorted trie: distinct tuples over its columns in global variable order
+    struct Relation {
+        std::vector<size_t> variables;
+        std::vector<Row> tuples;
+        std::vector<size_t> counts; // multiplicity of each distinct tuple
+        size_t lo = 0;
+        size_t hi = 0;
+    };
+
+    std::vector<std::string> variables;
+    std::vector<Value::Type> variableTypes;
+    std::vector<size_t> variableNumChars;
+    std::vector<Relation> relations;
+    std::vector<std::vector<std::pair<size_t, size_t>>> relationsByVariable; // (relation, column position)
+
+    std::vector<size_t> outputVariables;
+    Row binding;
+    Table output;
+
+    void join(size_t variable);
+    void emit();
+
+public:
+    // output columns must name every input column exactly once
+    GenericJoin(const std::vector<const Table*>& inputs, const std::vector<std::string>& outputColumns);
+
+    Table execute();
+};
+
+#endif
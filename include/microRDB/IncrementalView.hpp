@@ -0,0 +1,99 @@
+// IncrementalView.hpp
+
+#ifndef INCREMENTALVIEW
+#define INCREMENTALVIEW
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "microRDB/Arena.hpp"
+#include "microRDB/Node.hpp"
+#include "microRDB/Table.hpp"
+#include "microRDB/Value.hpp"
+
+class Catalog;
+
+// rows with multiplicities, a change to a relation carries -1 for every removed row and +1 for every added one
+using ZSet = std::unordered_map<Row, long, RowHash>;
+
+// add weight to a row's multiplicity, rows whose changes cancel out are dropped
+inline void accumulate(ZSet& zset, const Row& row, long weight) {
+    if (weight == 0) {
+        return;
+    }
+    auto found = zset.try_emplace(row, 0).first;
+    found->second += weight;
+    if (found->second == 0) {
+        zset.erase(found);
+    }
+}
+
+// one operator of a view's delta plan, mirroring the relational expression it was planned from
+struct DeltaNode {
+    enum Kind {
+        scan,
+        select,
+        project,
+        unite,
+        difference,
+        intersect,
+        join,
+    };
+
+    Kind kind;
+    std::vector<Column> columns; // output
+    std::vector<std::unique_ptr<DeltaNode>> inputs;
+
+    std::string tableName; // scan
+    const Node::Node* predicate = nullptr; // select, in the view's own copy
+    std::vector<size_t> ordinals; // project: input columns kept, join: right columns appended
+    std::vector<size_t> leftKey; // join: shared columns on each side
+    std::vector<size_t> rightKey;
+
+    // set operators count every row of each input, joins index each input on its key
+    ZSet counts[2];
+    std::unordered_map<Row, ZSet, RowHash> indexes[2];
+
+    DeltaNode(Kind kind)
+        : kind(kind) {}
+};
+
+// a table kept equal to a relational expression by pushing the changes of the tables it reads through
+// a delta plan: select and project are linear, a join combines each side's change with the other side's
+// indexed rows, set operators keep row counts per input and emit a row when its presence flips
+class IncrementalView {
+public:
+    // evaluates a select predicate of the plan against one of its input rows
+    using Condition = std::function<bool(const Node::Node* predicate, const Row& row)>;
+
+private:
+    std::unique_ptr<Arena> arena; // predicates copied out of the defining statement
+    std::unique_ptr<DeltaNode> root;
+    std::vector<std::string> tables;
+    bool stateful = false;
+
+    ZSet propagate(DeltaNode& node, const std::string& table, const ZSet& change, const Condition& condition);
+
+public:
+    // plan a bound relational expression, $ parameters are fixed to their current values
+    IncrementalView(const Node::Node* definition, const Catalog& catalog, const std::vector<Value>* parameters = nullptr);
+
+    // tables the view reads, in first-read order
+    const std::vector<std::string>& sourceTables() const { return tables; }
+
+    // the delta plan, its root has the view's columns
+    const DeltaNode& plan() const { return *root; }
+
+    // joins and set operators keep state, a plan without them is selects and projects over one table
+    bool isStateful() const { return stateful; }
+
+    // build the join indexes and set operator counts from the current contents of the source tables
+    void initialize(const Catalog& catalog, const Condition& condition);
+
+    // change to the view's rows for a change to one of its source tables
+    ZSet propagate(const std::string& table, const ZSet& change, const Condition& condition);
+};
+
+#endif
@@ -0,0 +1,47 @@
+// JoinOrderer.hpp
+
+#ifndef JOINORDERER
+#define JOINORDERER
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "microRDB/CardinalityEstimator.hpp"
+
+// join tree over the leaves of a flattened ^ chain
+struct JoinPlan {
+    int leaf = -1; // index into the chain's leaves, -1 for a join
+    std::unique_ptr<JoinPlan> build; // smaller estimated input, hashed
+    std::unique_ptr<JoinPlan> probe;
+    RelationEstimate estimate;
+    double cost = 0.0; // sum of estimated intermediate result sizes
+
+    JoinPlan(int leaf, const RelationEstimate& estimate)
+        : leaf(leaf), estimate(estimate) {}
+    JoinPlan(std::unique_ptr<JoinPlan> build, std::unique_ptr<JoinPlan> probe, const RelationEstimate& estimate, double cost)
+        : build(std::move(build)), probe(std::move(probe)), estimate(estimate), cost(cost) {}
+
+    // build side printed first
+    std::string toString(const std::vector<std::string>& leafNames) const;
+};
+
+// cost-based join ordering: exhaustive dynamic programming over subsets for short chains,
+// greedy smallest-result-first pairing beyond that
+class JoinOrderer {
+private:
+    std::unique_ptr<JoinPlan> orderDynamicProgramming(const std::vector<RelationEstimate>& leaves);
+    std::unique_ptr<JoinPlan> orderGreedy(const std::vector<RelationEstimate>& leaves);
+
+public:
+    static constexpr size_t maxDynamicProgrammingLeaves = 10;
+
+    std::unique_ptr<JoinPlan> order(const std::vector<RelationEstimate>& leaves);
+
+    // GYO reduction over the shared-column hypergraph, cyclic chains are better served by a multi-way join
+    static bool isCyclic(const std::vector<RelationEstimate>& leaves);
+
+    // join two subplans, choosing the smaller estimated input as the build side
+    static std::unique_ptr<JoinPlan> join(std::unique_ptr<JoinPlan> a, std::unique_ptr<JoinPlan> b);
+};
+
+#endif
@@ -3,14 +3,29 @@
 #ifndef LEXER
 #define LEXER
 
+#include <string_view>
 #include <vector>
 #include "microRDB/Token.hpp"
 
 class Lexer {
 private:
-    
+    // classify whole blocks of input at once when skipping runs of one character class
+    bool vectorized;
+
 public:
+    Lexer(bool vectorized = true)
+        : vectorized(vectorized) {}
+
+    // tokens own copies of their values
     std::vector<Token> lex(const std::string& text);
+
+    // zero-copy mode, token values are views into text, which must outlive them
+    // the token buffer is reserved once from the length of text, so lexing allocates almost nothing
+    std::vector<TokenView> lexViews(std::string_view text, uint32_t firstLineNumber = 1);
+
+    // index one past the first ; at or after from that is outside chars literals and comments
+    // npos if the statement is not complete within text
+    size_t findStatementEnd(std::string_view text, size_t from) const;
 };
 
 #endif
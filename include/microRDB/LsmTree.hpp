@@ -0,0 +1,147 @@
+// LsmTree.hpp
+
+#ifndef LSMTREE
+#define LSMTREE
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "microRDB/BloomFilter.hpp"
+#include "microRDB/DeletionBitmap.hpp"
+#include "microRDB/Table.hpp"
+
+// the rows of an append-mostly table as a log-structured merge tree of files in a directory
+// appended rows collect in a memtable, a full memtable is written out as an immutable run sorted by the first column
+// a background thread writes runs and merges them tiered, fanout runs of a level into one run of the next level
+// every run keeps a Bloom filter and every fenceInterval-th key in memory, so a point lookup reads a block of the
+// runs that may hold its key, rows come back in insertion order either way
+// deletes and updates add tombstones for the versions they replace, an update appends the new version at the old
+// one's place, merges drop tombstoned records
+// runs are scratch files removed with the tree, the write-ahead log keeps the table durable
+class LsmTree {
+public:
+    // a version of a row, identified by its write, and the row's place in insertion order
+    struct RowId {
+        uint64_t sequence;
+        uint64_t position;
+    };
+
+    static constexpr size_t memtableRows = 1 << 16;
+    static constexpr size_t fanout = 4;
+    static constexpr size_t fenceInterval = 128;
+
+    // full memtables waiting for the background thread before appends wait for it
+    static constexpr size_t maxImmutables = 2;
+
+private:
+    struct Entry {
+        uint64_t sequence;
+        uint64_t position;
+        Row row;
+    };
+
+    // records sorted by key then sequence, the file is removed once no reader holds the run
+    struct Run {
+        std::string path;
+        int fd = -1;
+        size_t level = 0;
+        size_t numRecords = 0;
+        BloomFilter bloom;
+        std::vector<Value> fences; // key of every fenceInterval-th record
+
+        Run(const std::string& path, size_t level, size_t numRecords);
+        ~Run();
+    };
+
+    std::string directory;
+    std::string name;
+    std::vector<Column> columns;
+    size_t recordSize = 0; // sequence number, position, then every column, zero padded chars
+
+    std::mutex mutex;
+    std::condition_variable wake; // the background thread, for an immutable memtable or a full level
+    std::condition_variable drained; // appends, for room among the immutable memtables
+
+    std::vector<Entry> memtable;
+    std::vector<std::shared_ptr<const std::vector<Entry>>> immutables; // oldest first
+    std::vector<std::shared_ptr<const Run>> runs;
+    uint64_t numWrites = 0;
+    uint64_t numPositions = 0;
+    DeletionBitmap tombstones; // sequence numbers of deleted and updated versions, written under the lock
+
+    // copies of the memtable and the tombstones for views, dropped by the next write
+    std::shared_ptr<const std::vector<Entry>> memtableCopy;
+    std::shared_ptr<const DeletionBitmap> tombstonesCopy;
+    size_t nextRunId = 0;
+    bool stopping = false;
+    std::thread thread;
+
+    void encode(const Entry& entry, char* record) const;
+    Entry decode(const char* record) const;
+    Value keyOf(const char* record) const;
+
+    // write sorted records to a new run of a level, without the lock
+    // nextRecord fills in a record and is false once there are none left, at most maxRecords
+    template <typename NextRecord>
+    std::shared_ptr<const Run> writeRun(size_t level, size_t maxRecords, NextRecord nextRecord);
+
+    std::shared_ptr<const Run> flush(const std::vector<Entry>& entries);
+    std::shared_ptr<const Run> merge(const std::vector<std::shared_ptr<const Run>>& inputs, const DeletionBitmap& dropped);
+
+    // add a version to the memtable, sealing it once full
+    void add(Entry entry);
+
+    // the live versions among memtables and runs, in insertion order
+    std::vector<Row> collect(const std::vector<const std::vector<Entry>*>& memtables,
+                             const std::vector<std::shared_ptr<const Run>>& stored, const DeletionBitmap& dead,
+                             uint64_t positions, std::vector<RowId>* ids) const;
+
+    // runs of the lowest level with fanout of them, empty if no level is full
+    std::vector<std::shared_ptr<const Run>> fullLevel() const;
+
+    void backgroundLoop();
+
+public:
+    // the tree as one moment left it, its rows can be read on any thread while the tree takes more writes
+    struct View {
+        std::vector<std::shared_ptr<const std::vector<Entry>>> memtables;
+        std::vector<std::shared_ptr<const Run>> runs;
+        std::shared_ptr<const DeletionBitmap> tombstones;
+        uint64_t numPositions = 0;
+    };
+
+    LsmTree(const std::string& directory, const std::string& name, const std::vector<Column>& columns);
+    ~LsmTree();
+
+    LsmTree(const LsmTree&) = delete;
+    LsmTree& operator=(const LsmTree&) = delete;
+
+    void append(std::vector<Row> appended);
+
+    // every row, in insertion order, with the id of each in ids if given
+    std::vector<Row> rows(std::vector<RowId>* ids = nullptr);
+
+    // only on the thread writing the tree, the memtable is copied if it changed since the last view
+    View view();
+
+    // every row of a view, in insertion order, on any thread
+    std::vector<Row> rows(const View& view) const;
+
+    // rows whose first column equals key, in insertion order
+    std::vector<Row> lookup(const Value& key);
+
+    // delete rows by the ids rows() gave them
+    void erase(const std::vector<RowId>& erased);
+
+    // new versions of rows, each in place of the version with its id
+    void update(const std::vector<RowId>& replaced, std::vector<Row> updated);
+
+    size_t size() const { return numWrites - tombstones.count(); }
+    size_t numRuns();
+};
+
+#endif
@@ -3,199 +3,341 @@
 #ifndef NODE
 #define NODE
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
+#include "microRDB/Arena.hpp"
+#include "microRDB/Value.hpp"
 #include "microRDB/Visitor.hpp"
 
 namespace Node {
 
+    // nodes live in an arena owned by their Script and are never freed one at a time
+    // Ref and List are non-owning and trivially destructible, so are the nodes holding them
+
+    // child pointer
+    template <typename T>
+    class Ref {
+    private:
+        T* pointer = nullptr;
+
+    public:
+        Ref() = default;
+        Ref(std::nullptr_t) {}
+        Ref(T* pointer) : pointer(pointer) {}
+        template <typename U>
+        Ref(const Ref<U>& other) : pointer(other.get()) {}
+
+        T* get() const { return pointer; }
+        T* operator->() const { return pointer; }
+        T& operator*() const { return *pointer; }
+        explicit operator bool() const { return pointer != nullptr; }
+    };
+
+    // child list, an array in the arena
+    template <typename T>
+    class List {
+    private:
+        const Ref<T>* items = nullptr;
+        size_t count = 0;
+
+    public:
+        List() = default;
+        List(const Ref<T>* items, size_t count) : items(items), count(count) {}
+
+        const Ref<T>* begin() const { return items; }
+        const Ref<T>* end() const { return items + count; }
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        const Ref<T>& operator[](size_t i) const { return items[i]; }
+    };
+
+    // comparison and arithmetic operators
+    enum Operator : uint8_t {
+        opEquals,
+        opNotEquals,
+        opLessThan,
+        opGreaterThan,
+        opLessThanOrEquals,
+        opGreaterThanOrEquals,
+        opPlus,
+        opMinus,
+        opMultiply,
+        opDivide,
+        opModulus,
+    };
+
+    inline const char* operatorString(Operator op) {
+        switch (op) {
+            case opEquals: return "==";
+            case opNotEquals: return "!=";
+            case opLessThan: return "<";
+            case opGreaterThan: return ">";
+            case opLessThanOrEquals: return "<=";
+            case opGreaterThanOrEquals: return ">=";
+            case opPlus: return "+";
+            case opMinus: return "-";
+            case opMultiply: return "*";
+            case opDivide: return "/";
+            case opModulus: return "%";
+        }
+        return "";
+    }
+
+    // result type of a scalar expression, filled in by the Binder before execution
+    struct Binding {
+        Value::Type type = Value::intType;
+        size_t numChars = 0; // chars expressions only
+    };
+
     // node
     struct Node {
+        mutable Binding binding; // scalar expressions only
         virtual void accept(Visitor* v) const {}
     };
 
     // script
+    // the only node on the heap, owns the arenas holding the rest of the tree
     struct Script : Node {
-        const std::vector<std::unique_ptr<Node>> statements;
+        const std::vector<std::unique_ptr<Arena>> arenas;
+        const std::vector<Ref<Node>> statements;
 
-        Script(std::vector<std::unique_ptr<Node>>& statements) : statements(std::move(statements)) {}
+        Script(std::vector<Ref<Node>>& statements, std::vector<std::unique_ptr<Arena>>& arenas)
+            : arenas(std::move(arenas)), statements(std::move(statements)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // create
     struct Create : Node {
-        const std::string tableName;
-        const std::unique_ptr<Node> expression;
+        const std::string& tableName; // interned
+        const Ref<Node> expression;
+        const bool maintained; // kept up to date as the tables it reads change
 
-        Create(const std::string& tableName, std::unique_ptr<Node> expression) : tableName(tableName), expression(std::move(expression)) {}
+        Create(std::string_view tableName, Ref<Node> expression, bool maintained = false)
+            : tableName(intern(tableName)), expression(std::move(expression)), maintained(maintained) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // name-type list
     struct NameTypeList : Node {
-        const std::vector<std::unique_ptr<Node>> nameTypePairs;
+        const List<Node> nameTypePairs;
 
-        NameTypeList(std::vector<std::unique_ptr<Node>>& nameTypePairs)
+        NameTypeList(List<Node> nameTypePairs)
             : nameTypePairs(std::move(nameTypePairs)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // name-type pair
     struct NameTypePair : Node {
-        const std::string name;
-        const std::string type;
-        const std::string numChars;
-
-        NameTypePair(const std::string& name, const std::string& type)
-            : name(name), type(type), numChars("") {}
-        NameTypePair(const std::string& name, const std::string& type, const std::string& numChars)
-            : name(name), type(type), numChars(numChars) {}
+        const std::string& name; // interned
+        const std::string& type; // interned
+        const std::string& numChars; // interned
+
+        NameTypePair(std::string_view name, std::string_view type)
+            : name(intern(name)), type(intern(type)), numChars(intern("")) {}
+        NameTypePair(std::string_view name, std::string_view type, std::string_view numChars)
+            : name(intern(name)), type(intern(type)), numChars(intern(numChars)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // drop
     struct Drop : Node {
-        const std::string tableName;
+        const std::string& tableName; // interned
         
-        Drop(const std::string& tableName)
-            : tableName(tableName) {}
+        Drop(std::string_view tableName)
+            : tableName(intern(tableName)) {}
+        void accept(Visitor* v) const { v->visit(this); }
+    };
+
+    // analyze
+    struct Analyze : Node {
+        const std::string& tableName; // interned
+
+        Analyze(std::string_view tableName)
+            : tableName(intern(tableName)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // filter
     struct Filter : Node {
-        const std::unique_ptr<Node> expr;
-        Filter(std::unique_ptr<Node> expr) : expr(std::move(expr)) {}
+        const Ref<Node> expr;
+        Filter(Ref<Node> expr) : expr(std::move(expr)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // update
     struct Update : Node {
-        const std::string tableName;
-        const std::unique_ptr<Node> assignList;
-        const std::vector<std::unique_ptr<Filter>> filters;
+        const std::string& tableName; // interned
+        const Ref<Node> assignList;
+        const List<Filter> filters;
 
-        Update(const std::string& tableName, std::unique_ptr<Node> assignList, std::vector<std::unique_ptr<Filter>>& filters)
-            : tableName(tableName), assignList(std::move(assignList)), filters(std::move(filters)) {}
+        Update(std::string_view tableName, Ref<Node> assignList, List<Filter> filters)
+            : tableName(intern(tableName)), assignList(std::move(assignList)), filters(std::move(filters)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // assign list
     struct AssignList : Node {
-        const std::vector<std::unique_ptr<Node>> assigns;
-        AssignList(std::vector<std::unique_ptr<Node>>& assigns) : assigns(std::move(assigns)) {}
+        const List<Node> assigns;
+        AssignList(List<Node> assigns) : assigns(std::move(assigns)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // assign
     struct Assign : Node {
-        const std::string name;
-        const std::unique_ptr<Node> expr;
-        Assign(const std::string& name, std::unique_ptr<Node> expr)
-            : name(name), expr(std::move(expr)) {}
+        const std::string& name; // interned
+        const Ref<Node> expr;
+        mutable int ordinal = -1; // of the assigned column, set by the Binder
+        Assign(std::string_view name, Ref<Node> expr)
+            : name(intern(name)), expr(std::move(expr)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // delete
     struct Delete : Node {
-        const std::string tableName;
-        const std::vector<std::unique_ptr<Filter>> filters;
+        const std::string& tableName; // interned
+        const List<Filter> filters;
 
-        Delete(const std::string& tableName, std::vector<std::unique_ptr<Filter>>& filters)
-            : tableName(tableName), filters(std::move(filters)) {}
+        Delete(std::string_view tableName, List<Filter> filters)
+            : tableName(intern(tableName)), filters(std::move(filters)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
 
     // insert
     struct Insert : Node {
-        const std::string tableName;
-        const std::vector<std::unique_ptr<Node>> expressionLists;
+        const std::string& tableName; // interned
+        const List<Node> expressionLists;
 
-        Insert(const std::string& tableName, std::vector<std::unique_ptr<Node>>& expressionLists) 
-            : tableName(tableName), expressionLists(std::move(expressionLists)) {}
+        Insert(std::string_view tableName, List<Node> expressionLists) 
+            : tableName(intern(tableName)), expressionLists(std::move(expressionLists)) {}
+        void accept(Visitor* v) const { v->visit(this); }
+    };
+
+    // literal value of a bulk insert, parsed straight from its token
+    struct Literal {
+        enum Type : uint8_t {
+            intType,
+            floatType,
+            boolType,
+            charsType,
+        };
+
+        Type type;
+        union {
+            int intValue;
+            float floatValue;
+            bool boolValue;
+        };
+        std::string_view charsValue; // copied into the tree's arena
+    };
+
+    // bulk insert
+    // an insert whose values are all literals, kept row major instead of as expression nodes
+    struct BulkInsert : Node {
+        const std::string& tableName; // interned
+        const size_t numRows;
+        const size_t numColumns;
+        const Literal* const literals; // numRows * numColumns
+
+        BulkInsert(std::string_view tableName, size_t numRows, size_t numColumns, const Literal* literals)
+            : tableName(intern(tableName)), numRows(numRows), numColumns(numColumns), literals(literals) {}
+        const Literal* row(size_t r) const { return literals + r * numColumns; }
+        void accept(Visitor* v) const { v->visit(this); }
+    };
+
+    // load
+    struct Load : Node {
+        const std::string& tableName; // interned
+        const std::string_view path; // copied into the tree's arena
+
+        Load(std::string_view tableName, std::string_view path)
+            : tableName(intern(tableName)), path(path) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // expression list
     struct ExpressionList : Node {
-        const std::vector<std::unique_ptr<Node>> expressions;
+        const List<Node> expressions;
 
-        ExpressionList(std::vector<std::unique_ptr<Node>>& expressions) 
+        ExpressionList(List<Node> expressions) 
             : expressions(std::move(expressions)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // or expression
     struct OrExpression : Node {
-        const std::unique_ptr<Node> LHS;
-        const std::unique_ptr<Node> RHS;
+        const Ref<Node> LHS;
+        const Ref<Node> RHS;
 
-        OrExpression(std::unique_ptr<Node> LHS, std::unique_ptr<Node> RHS)
+        OrExpression(Ref<Node> LHS, Ref<Node> RHS)
             : LHS(std::move(LHS)), RHS(std::move(RHS)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // and expression
     struct AndExpression : Node {
-        const std::unique_ptr<Node> LHS;
-        const std::unique_ptr<Node> RHS;
+        const Ref<Node> LHS;
+        const Ref<Node> RHS;
 
-        AndExpression(std::unique_ptr<Node> LHS, std::unique_ptr<Node> RHS)
+        AndExpression(Ref<Node> LHS, Ref<Node> RHS)
             : LHS(std::move(LHS)), RHS(std::move(RHS)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // equality expression
     struct EqualityExpression : Node {
-        const std::unique_ptr<Node> LHS;
-        const std::unique_ptr<Node> RHS;
-        const std::string op; // ==, !=
+        const Ref<Node> LHS;
+        const Ref<Node> RHS;
+        const Operator op; // ==, !=
 
-        EqualityExpression(std::unique_ptr<Node> LHS, std::unique_ptr<Node> RHS, const std::string& op)
+        EqualityExpression(Ref<Node> LHS, Ref<Node> RHS, Operator op)
             : LHS(std::move(LHS)), RHS(std::move(RHS)), op(op) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // relational expression
     struct RelationalExpression : Node {
-        const std::unique_ptr<Node> LHS;
-        const std::unique_ptr<Node> RHS;
-        const std::string op; // <, >, <=, >=
+        const Ref<Node> LHS;
+        const Ref<Node> RHS;
+        const Operator op; // <, >, <=, >=
 
-        RelationalExpression(std::unique_ptr<Node> LHS, std::unique_ptr<Node> RHS, const std::string& op)
+        RelationalExpression(Ref<Node> LHS, Ref<Node> RHS, Operator op)
             : LHS(std::move(LHS)), RHS(std::move(RHS)), op(op) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // additive expression
     struct AdditiveExpression : Node {
-        const std::unique_ptr<Node> LHS;
-        const std::unique_ptr<Node> RHS;
-        const std::string op; // +, -
+        const Ref<Node> LHS;
+        const Ref<Node> RHS;
+        const Operator op; // +, -
 
-        AdditiveExpression(std::unique_ptr<Node> LHS, std::unique_ptr<Node> RHS, const std::string& op)
+        AdditiveExpression(Ref<Node> LHS, Ref<Node> RHS, Operator op)
             : LHS(std::move(LHS)), RHS(std::move(RHS)), op(op) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // multiplicative expression
     struct MultiplicativeExpression : Node {
-        const std::unique_ptr<Node> LHS;
-        const std::unique_ptr<Node> RHS;
-        const std::string op; // *, /, %
+        const Ref<Node> LHS;
+        const Ref<Node> RHS;
+        const Operator op; // *, /, %
 
-        MultiplicativeExpression(std::unique_ptr<Node> LHS, std::unique_ptr<Node> RHS, const std::string& op)
+        MultiplicativeExpression(Ref<Node> LHS, Ref<Node> RHS, Operator op)
             : LHS(std::move(LHS)), RHS(std::move(RHS)), op(op) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // identifier
     struct Identifier : Node {
-        const std::string name;
+        const std::string& name; // interned
+        mutable int ordinal = -1; // of the referenced column when used as a scalar, set by the Binder
 
-        Identifier(const std::string& name)
-            : name(name) {}
+        Identifier(std::string_view name)
+            : name(intern(name)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
@@ -228,75 +370,84 @@ namespace Node {
 
     // chars literal
     struct CharsLiteral : Node {
-        const std::string value;
-        CharsLiteral(const std::string& value)
+        const std::string_view value; // copied into the tree's arena
+        CharsLiteral(std::string_view value)
             : value(value) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
+    // parameter
+    struct Parameter : Node {
+        const int index; // $1 is 1
+
+        Parameter(int index)
+            : index(index) {}
+        void accept(Visitor* v) const { v->visit(this); }
+    };
+
     // select expression
     struct SelectExpression : Node {
-        const std::unique_ptr<Node> LHS; // SelectExpression or ProjectExpression
-        const std::unique_ptr<Node> RHS; // ORExpression
+        const Ref<Node> LHS; // SelectExpression or ProjectExpression
+        const Ref<Node> RHS; // ORExpression
 
-        SelectExpression(std::unique_ptr<Node> LHS, std::unique_ptr<Node> RHS)
+        SelectExpression(Ref<Node> LHS, Ref<Node> RHS)
             : LHS(std::move(LHS)), RHS(std::move(RHS)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // project expression
     struct ProjectExpression : Node {
-        const std::unique_ptr<Node> LHS; // ProjectExpression or UnionExpression
-        const std::unique_ptr<Node> RHS; // ColumnList
+        const Ref<Node> LHS; // ProjectExpression or UnionExpression
+        const Ref<Node> RHS; // ColumnList
 
-        ProjectExpression(std::unique_ptr<Node> LHS, std::unique_ptr<Node> RHS)
+        ProjectExpression(Ref<Node> LHS, Ref<Node> RHS)
             : LHS(std::move(LHS)), RHS(std::move(RHS)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // column list
     struct ColumnList : Node {
-        const std::vector<std::unique_ptr<Identifier>> columns;
-        ColumnList(std::vector<std::unique_ptr<Identifier>>& columns) : columns(std::move(columns)) {}
+        const List<Identifier> columns;
+        ColumnList(List<Identifier> columns) : columns(std::move(columns)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // union expression
     struct UnionExpression : Node {
-        const std::unique_ptr<Node> LHS;
-        const std::unique_ptr<Node> RHS;
+        const Ref<Node> LHS;
+        const Ref<Node> RHS;
 
-        UnionExpression(std::unique_ptr<Node> LHS, std::unique_ptr<Node> RHS)
+        UnionExpression(Ref<Node> LHS, Ref<Node> RHS)
             : LHS(std::move(LHS)), RHS(std::move(RHS)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // diff expression
     struct DifferenceExpression : Node {
-        const std::unique_ptr<Node> LHS;
-        const std::unique_ptr<Node> RHS;
+        const Ref<Node> LHS;
+        const Ref<Node> RHS;
 
-        DifferenceExpression(std::unique_ptr<Node> LHS, std::unique_ptr<Node> RHS)
+        DifferenceExpression(Ref<Node> LHS, Ref<Node> RHS)
             : LHS(std::move(LHS)), RHS(std::move(RHS)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // intersect expression
     struct IntersectExpression : Node {
-        const std::unique_ptr<Node> LHS;
-        const std::unique_ptr<Node> RHS;
+        const Ref<Node> LHS;
+        const Ref<Node> RHS;
 
-        IntersectExpression(std::unique_ptr<Node> LHS, std::unique_ptr<Node> RHS)
+        IntersectExpression(Ref<Node> LHS, Ref<Node> RHS)
             : LHS(std::move(LHS)), RHS(std::move(RHS)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
 
     // join expression
     struct JoinExpression : Node {
-        const std::unique_ptr<Node> LHS;
-        const std::unique_ptr<Node> RHS;
+        const Ref<Node> LHS;
+        const Ref<Node> RHS;
 
-        JoinExpression(std::unique_ptr<Node> LHS, std::unique_ptr<Node> RHS)
+        JoinExpression(Ref<Node> LHS, Ref<Node> RHS)
             : LHS(std::move(LHS)), RHS(std::move(RHS)) {}
         void accept(Visitor* v) const { v->visit(this); }
     };
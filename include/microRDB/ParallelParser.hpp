@@ -0,0 +1,26 @@
+// ParallelParser.hpp
+
+#ifndef PARALLELPARSER
+#define PARALLELPARSER
+
+#include <memory>
+#include <string_view>
+#include "microRDB/Node.hpp"
+#include "microRDB/ThreadPool.hpp"
+
+// splits a script into pieces at top-level ; and lexes and parses the pieces on a thread pool
+// statements are stitched back together in script order
+class ParallelParser {
+private:
+    ThreadPool& pool;
+    size_t pieceSize;
+
+public:
+    // pieces are cut at the first statement end after pieceSize bytes
+    ParallelParser(ThreadPool& pool, size_t pieceSize = 1 << 20)
+        : pool(pool), pieceSize(pieceSize) {}
+
+    std::unique_ptr<Node::Script> parse(std::string_view text);
+};
+
+#endif
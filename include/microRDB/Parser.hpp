@@ -10,48 +10,97 @@
 
 class Parser {
 private:
-    const std::vector<Token>& tokens;
-    std::vector<Token>::const_iterator it;
+    std::vector<TokenView> ownedViews;
+    const TokenView* first;
+    const TokenView* last;
+    const TokenView* it;
+
+    // parsed nodes, owned by the Script they end up in
+    std::unique_ptr<Arena> arena;
+
+    // highest $ parameter index seen
+    int maxParameter = 0;
+
+    // children of the lists being parsed, nested lists stack on top of their parents
+    std::vector<Node::Node*> scratch;
+
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        return arena->make<T>(std::forward<Args>(args)...);
+    }
+
+    // move the children pushed since start into an arena list
+    template <typename T>
+    Node::List<T> makeList(size_t start) {
+        size_t count = scratch.size() - start;
+        auto* items = arena->makeArray<Node::Ref<T>>(count);
+        for (size_t i = 0; i < count; ++i) {
+            new (&items[i]) Node::Ref<T>(static_cast<T*>(scratch[start + i]));
+        }
+        scratch.resize(start);
+        return Node::List<T>(items, count);
+    }
 
     void discard(Token::Type expectedType);
-    std::string consume(Token::Type expectedType);
+    std::string_view consume(Token::Type expectedType);
+
+    // shape of an insert whose values are all lone literals, false if any value is an expression
+    bool literalRows(size_t& numRows, size_t& numColumns) const;
+    Node::Literal parseLiteral();
 
 public:
-    Parser(const std::vector<Token>& tokens) : tokens(tokens) {}
+    // tokens must outlive the parser
+    Parser(const std::vector<Token>& tokens);
+    Parser(const std::vector<TokenView>& tokens)
+        : first(tokens.data()), last(tokens.data() + tokens.size()), arena(std::make_unique<Arena>()) {}
+
     std::unique_ptr<Node::Script> parse();
+    std::vector<Node::Ref<Node::Node>> parseStatements();
+
+    // number of $ parameters a prepared statement needs, the highest index used
+    size_t numParameters() const { return maxParameter; }
+
+    // the arena holding everything parsed so far, for statements taken out of parseStatements
+    std::unique_ptr<Arena> takeArena() { return std::move(arena); }
     
-    std::unique_ptr<Node::Create> parseCreate();
-    std::unique_ptr<Node::NameTypeList> parseNameTypeList();
-    std::unique_ptr<Node::NameTypePair> parseNameTypePair();
+    Node::Create* parseCreate();
+    Node::NameTypeList* parseNameTypeList();
+    Node::NameTypePair* parseNameTypePair();
+
+    Node::Drop* parseDrop();
+
+    Node::Analyze* parseAnalyze();
 
-    std::unique_ptr<Node::Drop> parseDrop();
+    Node::Delete* parseDelete();
+    Node::Filter* parseFilter();
 
-    std::unique_ptr<Node::Delete> parseDelete();
-    std::unique_ptr<Node::Filter> parseFilter();
+    Node::Update* parseUpdate();
+    Node::AssignList* parseAssignList();
+    Node::Assign* parseAssign();
 
-    std::unique_ptr<Node::Update> parseUpdate();
-    std::unique_ptr<Node::AssignList> parseAssignList();
-    std::unique_ptr<Node::Assign> parseAssign();
+    Node::Node* parseInsert();
+    Node::BulkInsert* parseBulkInsert(std::string_view name, size_t numRows, size_t numColumns);
+    Node::ExpressionList* parseExpressionList();
 
-    std::unique_ptr<Node::Insert> parseInsert();
-    std::unique_ptr<Node::ExpressionList> parseExpressionList();
+    Node::Load* parseLoad();
 
-    std::unique_ptr<Node::Node> parseOrExpression();
-    std::unique_ptr<Node::Node> parseAndExpression();
-    std::unique_ptr<Node::Node> parseEqualityExpression();
-    std::unique_ptr<Node::Node> parseRelationalExpression();
-    std::unique_ptr<Node::Node> parseAdditiveExpression();
-    std::unique_ptr<Node::Node> parseMultiplicativeExpression();
-    std::unique_ptr<Node::Node> parsePrimary();
+    Node::Node* parseOrExpression();
+    Node::Node* parseAndExpression();
+    Node::Node* parseEqualityExpression();
+    Node::Node* parseRelationalExpression();
+    Node::Node* parseAdditiveExpression();
+    Node::Node* parseMultiplicativeExpression();
+    Node::Node* parsePrimary();
+    Node::Parameter* parseParameter();
     
-    std::unique_ptr<Node::Node> parseSelectExpression();
-    std::unique_ptr<Node::Node> parseProjectExpression();
-    std::unique_ptr<Node::Node> parseColumnList();
-    std::unique_ptr<Node::Node> parseUnionExpression();
-    std::unique_ptr<Node::Node> parseDifferenceExpression();
-    std::unique_ptr<Node::Node> parseIntersectExpression();
-    std::unique_ptr<Node::Node> parseJoinExpression();
-    std::unique_ptr<Node::Node> parseTablePrimary();
+    Node::Node* parseSelectExpression();
+    Node::Node* parseProjectExpression();
+    Node::Node* parseColumnList();
+    Node::Node* parseUnionExpression();
+    Node::Node* parseDifferenceExpression();
+    Node::Node* parseIntersectExpression();
+    Node::Node* parseJoinExpression();
+    Node::Node* parseTablePrimary();
 
     //std::unique_ptr<Node::> parse();
 };
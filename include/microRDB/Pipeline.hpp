@@ -0,0 +1,82 @@
+// Pipeline.hpp
+
+#ifndef PIPELINE
+#define PIPELINE
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "microRDB/BloomFilter.hpp"
+#include "microRDB/Table.hpp"
+#include "microRDB/Visitor.hpp"
+
+// Bloom filter over a hash join's build keys, pushed into the probe side
+struct RuntimeFilter {
+    BloomFilter bloom;
+    std::vector<std::string> keys;
+    size_t tested = 0;
+    size_t passed = 0;
+
+    RuntimeFilter(size_t expectedKeys)
+        : bloom(expectedKeys) {}
+};
+
+// hash join build side, a pipeline breaker
+struct JoinHashTable {
+    Table build;
+    std::vector<bool> buildIsKey;
+    std::unordered_map<Row, std::vector<size_t>, RowHash> buckets;
+};
+
+// one fused operator of a pipeline
+struct PipelineStep {
+    enum Kind {
+        filterStep,
+        projectStep,
+        probeStep,
+        runtimeFilterStep,
+    };
+
+    Kind kind;
+    Table schema; // columns of the rows entering this step
+    const Node::Node* predicate = nullptr; // filter
+    std::vector<size_t> indices; // kept columns for project, key columns for probe and runtime filter
+    const JoinHashTable* hashTable = nullptr; // probe
+    RuntimeFilter* filter = nullptr; // runtime filter
+
+    PipelineStep(Kind kind, const Table& schema)
+        : kind(kind), schema(schema) {}
+};
+
+// push-based pipeline: one loop over a source pushes every row through the fused steps into a materializing sink
+// pipeline breakers (hash builds, set operations, multi-way joins) are run beforehand and become sources or hash tables
+struct Pipeline {
+    const Table* source = nullptr;
+    std::string sourceName;
+    std::vector<PipelineStep> steps;
+    Table schema; // columns leaving the last step
+
+    std::vector<std::unique_ptr<Table>> ownedTables;
+    std::vector<std::unique_ptr<JoinHashTable>> hashTables;
+    std::vector<std::unique_ptr<RuntimeFilter>> filters;
+    std::vector<std::string> filterDescriptions;
+
+    // scan a table that outlives the pipeline
+    void scan(const Table* table, const std::string& name);
+
+    // scan a materialized breaker result
+    void scan(Table table, const std::string& name);
+
+    void addFilter(const Node::Node* predicate);
+    void addProject(const std::vector<std::string>& columnNames);
+
+    // natural join against a build side hashed on the columns it shares with the current schema
+    void addProbe(Table build);
+
+    void addRuntimeFilter(RuntimeFilter* filter);
+
+    std::string toString() const;
+};
+
+#endif
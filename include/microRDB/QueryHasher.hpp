@@ -0,0 +1,144 @@
+// QueryHasher.hpp
+
+#ifndef QUERYHASHER
+#define QUERYHASHER
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "microRDB/Node.hpp"
+#include "microRDB/Value.hpp"
+#include "microRDB/Visitor.hpp"
+
+// structural hash of a read-only relational expression, equal for queries written the same way
+// $ parameters hash as the literals they stand for
+class QueryHasher : public Visitor {
+private:
+    // values of the $ parameters of the query
+    const std::vector<Value>* parameters;
+
+    // hash of the most recently visited node
+    uint64_t hash = 0;
+    bool hashingScalar = false;
+
+    // base tables the query reads, in first-read order
+    std::vector<std::string> tables;
+
+    uint64_t hashOf(const Node::Node* n);
+    uint64_t hashScalar(const Node::Node* expr);
+    uint64_t hashBinary(uint64_t tag, const Node::Node* LHS, const Node::Node* RHS, Node::Operator op);
+
+public:
+    QueryHasher(const std::vector<Value>* parameters = nullptr)
+        : parameters(parameters) {}
+
+    // hash of a relational expression
+    uint64_t hashQuery(const Node::Node* query);
+
+    // tables the last hashed query reads
+    const std::vector<std::string>& tablesRead() const { return tables; }
+
+    // visit script
+    void visit(const Node::Script* n) override;
+
+    // visit create
+    void visit(const Node::Create* n) override;
+
+    // visit name-type list
+    void visit(const Node::NameTypeList* n) override;
+
+    // visit name-type pair
+    void visit(const Node::NameTypePair* n) override;
+
+    // visit drop
+    void visit(const Node::Drop* n) override;
+
+    // visit analyze
+    void visit(const Node::Analyze* n) override;
+
+    // visit delete
+    void visit(const Node::Delete* n) override;
+
+    // visit filter
+    void visit(const Node::Filter* n) override;
+
+    // visit update
+    void visit(const Node::Update* n) override;
+
+    // visit assign list
+    void visit(const Node::AssignList* n) override;
+
+    // visit assign
+    void visit(const Node::Assign* n) override;
+
+    // visit insert
+    void visit(const Node::Insert* n) override;
+
+    // visit bulk insert
+    void visit(const Node::BulkInsert* n) override;
+
+    // visit load
+    void visit(const Node::Load* n) override;
+
+    // visit expression list
+    void visit(const Node::ExpressionList* n) override;
+
+    // visit or expression
+    void visit(const Node::OrExpression* n) override;
+
+    // visit and expression
+    void visit(const Node::AndExpression* n) override;
+
+    // visit equality expression
+    void visit(const Node::EqualityExpression* n) override;
+
+    // visit relational expression
+    void visit(const Node::RelationalExpression* n) override;
+
+    // visit additive expression
+    void visit(const Node::AdditiveExpression* n) override;
+
+    // visit multiplicative expression
+    void visit(const Node::MultiplicativeExpression* n) override;
+
+    // visit identifier
+    void visit(const Node::Identifier* n) override;
+
+    // visit int literal
+    void visit(const Node::IntLiteral* n) override;
+
+    // visit float literal
+    void visit(const Node::FloatLiteral* n) override;
+
+    // visit bool literal
+    void visit(const Node::BoolLiteral* n) override;
+
+    // visit chars literal
+    void visit(const Node::CharsLiteral* n) override;
+
+    // visit parameter
+    void visit(const Node::Parameter* n) override;
+
+    // visit select expression
+    void visit(const Node::SelectExpression* n) override;
+
+    // visit project expression
+    void visit(const Node::ProjectExpression* n) override;
+
+    // visit column list
+    void visit(const Node::ColumnList* n) override;
+
+    // visit union expression
+    void visit(const Node::UnionExpression* n) override;
+
+    // visit difference expression
+    void visit(const Node::DifferenceExpression* n) override;
+
+    // visit intersect expression
+    void visit(const Node::IntersectExpression* n) override;
+
+    // visit join expression
+    void visit(const Node::JoinExpression* n) override;
+};
+
+#endif
@@ -0,0 +1,52 @@
+// ResultCache.hpp
+
+#ifndef RESULTCACHE
+#define RESULTCACHE
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "microRDB/Catalog.hpp"
+#include "microRDB/Table.hpp"
+
+// results of read-only queries keyed on their QueryHasher hash, least recently used evicted first
+// an entry is only served for the same query text and while every table it read is still at the data version it was read at
+class ResultCache {
+private:
+    struct Entry {
+        uint64_t key;
+        std::string text; // StatementWriter text of the query, equal hashes of different queries must not share results
+        std::vector<std::pair<std::string, uint64_t>> tableVersions;
+        Table result;
+    };
+
+    size_t capacity;
+    size_t maxRows;
+
+    // most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+
+    size_t numHits = 0;
+    size_t numLookups = 0;
+
+public:
+    ResultCache(size_t capacity, size_t maxRows = 1 << 20)
+        : capacity(capacity), maxRows(maxRows) {}
+
+    // the cached result of a query, null if there is none or a table it read has changed since
+    const Table* find(uint64_t key, const std::string& text, const Catalog& catalog);
+
+    // remember the result of a query that read tables, results over maxRows rows are not kept
+    void insert(uint64_t key, const std::string& text, const std::vector<std::string>& tables, const Catalog& catalog,
+                const Table& result);
+
+    size_t hits() const { return numHits; }
+    size_t lookups() const { return numLookups; }
+    double hitRatio() const { return numLookups == 0 ? 0.0 : double(numHits) / numLookups; }
+};
+
+#endif
@@ -0,0 +1,57 @@
+// ScriptReader.hpp
+
+#ifndef SCRIPTREADER
+#define SCRIPTREADER
+
+#include <istream>
+#include <string>
+#include <string_view>
+#include "microRDB/Lexer.hpp"
+
+// reads a script one statement at a time, from a memory mapped file or from a stream in chunks
+// only the statement being read has to fit in memory
+class ScriptReader {
+private:
+    Lexer lexer;
+
+    // memory mapped file
+    const char* mapped = nullptr;
+    size_t mappedSize = 0;
+
+    // chunked stream, buffer holds the unconsumed tail of what was read
+    std::istream* stream = nullptr;
+    std::string buffer;
+
+    std::string_view text;
+    size_t position = 0;
+    uint32_t lineNumber = 1;
+    uint32_t statementLine = 1;
+
+    // append the next chunk of the stream, false at end of input
+    bool refill();
+
+    // consume text up to end
+    void advance(size_t end);
+
+public:
+    static constexpr size_t chunkSize = 1 << 20;
+
+    explicit ScriptReader(const std::string& path);
+    explicit ScriptReader(std::istream& stream);
+    ~ScriptReader();
+
+    ScriptReader(const ScriptReader&) = delete;
+    ScriptReader& operator=(const ScriptReader&) = delete;
+
+    // text of the next statement including its ;, valid until the next call
+    // the last statement may be missing its ;, false once the input is used up
+    bool next(std::string_view& statement);
+
+    // everything not yet read, the whole file for a freshly mapped script
+    std::string_view remaining() const { return text.substr(position); }
+
+    // line the last statement read starts on
+    uint32_t statementLineNumber() const { return statementLine; }
+};
+
+#endif
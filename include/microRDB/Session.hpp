@@ -0,0 +1,86 @@
+// Session.hpp
+
+#ifndef SESSION
+#define SESSION
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "microRDB/Catalog.hpp"
+#include "microRDB/Executor.hpp"
+#include "microRDB/Lexer.hpp"
+#include "microRDB/Node.hpp"
+#include "microRDB/Value.hpp"
+
+// statement text lexed and parsed once, its statements are bound again only when
+// the catalog's tables or the types of the $ parameters change
+struct PreparedStatement {
+    std::string normalizedText;
+    std::unique_ptr<Node::Script> script;
+    size_t numParameters = 0;
+
+    // what each statement's current binding was made for
+    static constexpr size_t unbound = ~size_t(0);
+    std::vector<size_t> boundSchemaVersions;
+    std::vector<Value::Type> boundParameterTypes;
+};
+
+// prepare/execute API over a catalog
+// prepared statements are cached by normalized text, the tokens with whitespace and comments dropped,
+// so texts differing only in layout share one parse and one binding
+// sessions on other threads share a catalog by running queries on snapshots, while one session writes
+class Session {
+private:
+    Catalog& catalog;
+    Executor executor;
+    Lexer lexer;
+
+    // queries run without the log, LSM trees or result cache, on a catalog of their own
+    ExecutionOptions queryOptions;
+    bool readsSnapshots = false; // a snapshot reader of the catalog since the first query
+
+    std::unordered_map<std::string, std::unique_ptr<PreparedStatement>> statements; // by normalized text
+    std::unordered_map<std::string, PreparedStatement*> seenTexts; // exact texts, skips lexing on a repeat
+    static constexpr size_t maxSeenTexts = 1 << 16;
+
+    size_t hits = 0;
+    size_t misses = 0;
+
+    static std::string normalize(const std::vector<TokenView>& tokens);
+
+    // terminate on a wrong number of parameters, forget the bindings made for other parameter types
+    void checkParameters(PreparedStatement& statement, const std::vector<Value>& parameters);
+
+    // bind statement i again if schema changed since its binding
+    void bind(PreparedStatement& statement, size_t i, const Catalog& schema, const std::vector<Value>& parameters);
+
+public:
+    Session(Catalog& catalog, const ExecutionOptions& options = ExecutionOptions());
+    ~Session();
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+    // the cached statement for text, parsed on first use
+    PreparedStatement& prepare(const std::string& text);
+
+    // run every statement of a prepared statement with values for $1, $2, ...
+    // bare select expressions print their result
+    void execute(PreparedStatement& statement, const std::vector<Value>& parameters = {});
+    void execute(const std::string& text, const std::vector<Value>& parameters = {}) {
+        execute(prepare(text), parameters);
+    }
+
+    // run a prepared query on a snapshot of the catalog as the last finished statement or transaction left it,
+    // without waiting for statements running on other threads, every statement of it reads the same snapshot
+    void query(PreparedStatement& statement, const std::vector<Value>& parameters = {});
+    void query(const std::string& text, const std::vector<Value>& parameters = {}) {
+        query(prepare(text), parameters);
+    }
+
+    size_t cacheHits() const { return hits; }
+    size_t cacheMisses() const { return misses; }
+};
+
+#endif
@@ -0,0 +1,83 @@
+// Statistics.hpp
+
+#ifndef STATISTICS
+#define STATISTICS
+
+#include <cstdint>
+#include <vector>
+#include "microRDB/Table.hpp"
+
+// HyperLogLog distinct count sketch
+class HyperLogLog {
+private:
+    static constexpr size_t precision = 10;
+    static constexpr size_t numRegisters = 1 << precision;
+    std::vector<uint8_t> registers = std::vector<uint8_t>(numRegisters, 0);
+
+public:
+    void add(uint64_t hash);
+    double estimate() const;
+    void clear();
+};
+
+// equi-depth histogram over a numeric column
+// kept approximately equi-depth under inserts by splitting overfull buckets and merging the emptiest neighbours
+class EquiDepthHistogram {
+private:
+    std::vector<double> bounds; // bucket i covers [bounds[i], bounds[i+1]]
+    std::vector<double> counts;
+    double total = 0.0;
+
+    size_t bucketOf(double value) const;
+    void split(size_t bucket);
+    void mergeSmallest();
+
+public:
+    static constexpr size_t maxBuckets = 32;
+
+    void build(std::vector<double> values);
+    void add(double value);
+    void remove(double value);
+    void clear();
+
+    bool empty() const { return counts.empty(); }
+    size_t numBuckets() const { return counts.size(); }
+
+    // fraction of values < value (or <= value if inclusive)
+    double fractionBelow(double value, bool inclusive) const;
+};
+
+// per-column statistics
+struct ColumnStatistics {
+    HyperLogLog sketch;
+    EquiDepthHistogram histogram; // numeric and bool columns only
+    bool hasHistogram = false;
+};
+
+// per-table statistics, maintained incrementally by the executor
+struct TableStatistics {
+    size_t rowCount = 0;
+    size_t modificationsSinceAnalyze = 0;
+    std::vector<ColumnStatistics> columns;
+
+    // full rebuild from table contents
+    void analyze(const Table& table);
+
+    void onInsert(const Row& row);
+    void onDelete(const Row& row);
+    void onUpdate(const Row& oldRow, const Row& newRow);
+
+    // a batch update counts its rows once and reports each overwritten cell on its own
+    void onUpdateRows(size_t numRows);
+    void onUpdateCell(size_t column, const Value& oldValue, const Value& newValue);
+
+    // sketches cannot forget overwritten or deleted values, so request a rebuild once enough rows changed
+    bool needsAnalyze() const;
+
+    // estimated number of distinct values in a column, capped by the row count
+    double distinctValues(size_t column) const;
+
+    void print(const Table& table) const;
+};
+
+#endif
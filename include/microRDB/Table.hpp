@@ -0,0 +1,45 @@
+// Table.hpp
+
+#ifndef TABLE
+#define TABLE
+
+#include <string>
+#include <vector>
+#include "microRDB/DeletionBitmap.hpp"
+#include "microRDB/Value.hpp"
+
+// column
+struct Column {
+    std::string name;
+    Value::Type type;
+    size_t numChars; // only meaningful for chars columns
+
+    Column(const std::string& name, Value::Type type, size_t numChars = 0)
+        : name(name), type(type), numChars(numChars) {}
+};
+
+// table, also used for intermediate relations during execution
+struct Table {
+    std::vector<Column> columns;
+    std::vector<Row> rows;
+
+    // rows deletes left in place, scans skip them, only catalog tables have any
+    DeletionBitmap deleted;
+
+    // index of the named column, -1 if not present
+    int columnIndex(const std::string& name) const;
+
+    // same number of columns with matching types
+    bool isUnionCompatible(const Table& other) const;
+
+    void print() const;
+
+    // the table without its deleted rows, for relations read from a catalog table
+    Table live() const;
+
+    // move up to maxRows live rows down over the deleted rows before them, from the first deleted row at or after from
+    // live rows keep their order, returns the row to resume at, rows.size() once every deleted row from from on is gone
+    size_t compact(size_t from, size_t maxRows);
+};
+
+#endif
@@ -0,0 +1,47 @@
+// ThreadPool.hpp
+
+#ifndef THREADPOOL
+#define THREADPOOL
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// work-stealing thread pool, every worker owns a deque and steals from the others' backs when idle
+class ThreadPool {
+private:
+    struct Worker {
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued{0};
+    bool stopping = false;
+
+    // own deque from the front, then steal from the others' backs starting at the next neighbour
+    bool tryRun(size_t self);
+    void workerLoop(size_t self);
+
+public:
+    // 0 threads means one per hardware thread
+    explicit ThreadPool(size_t numThreads = 0);
+    ~ThreadPool();
+
+    size_t size() const { return workers.size(); }
+
+    // run body over [0, count) in morsels of morselSize, blocking until all are done
+    // morsels are dealt round-robin across the workers' deques, the calling thread helps out
+    void parallelFor(size_t count, size_t morselSize, const std::function<void(size_t morsel, size_t begin, size_t end)>& body);
+};
+
+#endif
@@ -3,10 +3,12 @@
 #ifndef TOKEN
 #define TOKEN
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 struct Token {
-    enum Type {
+    enum Type : uint8_t {
         identifier,
         intLiteral,
         floatLiteral,
@@ -41,6 +43,7 @@ struct Token {
         questionMark,
         opWalrus,
         arrowLeft,
+        chevronLeft, // <<
         arrowRight,
         opUnion, // |
         opIntersect, // &
@@ -71,4 +74,21 @@ struct Token {
     std::string toString() const;
 };
 
+// compact token that slices its value out of the lexed text instead of owning it
+// only valid while that text is alive
+struct TokenView {
+    std::string_view value;
+    uint32_t lineNumber;
+    Token::Type type;
+
+    TokenView(Token::Type type, std::string_view value, uint32_t lineNumber)
+        : value(value), lineNumber(lineNumber), type(type) {}
+
+    operator Token::Type() const {
+        return type;
+    }
+
+    std::string toString() const;
+};
+
 #endif
@@ -0,0 +1,62 @@
+// Value.hpp
+
+#ifndef VALUE
+#define VALUE
+
+#include <string>
+#include <vector>
+
+struct Value {
+    enum Type {
+        intType,
+        floatType,
+        boolType,
+        charsType,
+    };
+
+    Type type;
+    int intValue = 0;
+    float floatValue = 0.0f;
+    bool boolValue = false;
+    std::string charsValue;
+
+    Value()
+        : type(intType) {}
+    Value(int value)
+        : type(intType), intValue(value) {}
+    Value(float value)
+        : type(floatType), floatValue(value) {}
+    Value(bool value)
+        : type(boolType), boolValue(value) {}
+    Value(const std::string& value)
+        : type(charsType), charsValue(value) {}
+    Value(const char* value)
+        : type(charsType), charsValue(value) {}
+
+    bool isNumeric() const {
+        return type == intType || type == floatType;
+    }
+
+    // numeric value as a double, bools as 0/1
+    double asDouble() const;
+
+    // 64 bit hash, well mixed for sketches and hash tables
+    size_t hash() const;
+
+    std::string toString() const;
+
+    static std::string typeName(Type type);
+};
+
+// total order: by type first, then by value
+bool operator==(const Value& lhs, const Value& rhs);
+bool operator!=(const Value& lhs, const Value& rhs);
+bool operator<(const Value& lhs, const Value& rhs);
+
+using Row = std::vector<Value>;
+
+struct RowHash {
+    size_t operator()(const Row& row) const;
+};
+
+#endif
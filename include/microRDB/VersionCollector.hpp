@@ -0,0 +1,40 @@
+// VersionCollector.hpp
+
+#ifndef VERSIONCOLLECTOR
+#define VERSIONCOLLECTOR
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// background garbage collector for table versions a write replaced while snapshots still read them
+// a retired version is freed on the collector's thread once no snapshot holds it, never on a reader's or writer's
+class VersionCollector {
+private:
+    std::vector<std::shared_ptr<const void>> retired;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::thread thread;
+
+    static constexpr std::chrono::milliseconds interval{50};
+
+    void collectLoop();
+
+public:
+    VersionCollector();
+    ~VersionCollector();
+
+    VersionCollector(const VersionCollector&) = delete;
+    VersionCollector& operator=(const VersionCollector&) = delete;
+
+    void retire(std::shared_ptr<const void> version);
+
+    // versions still held by a snapshot
+    size_t numRetired();
+};
+
+#endif
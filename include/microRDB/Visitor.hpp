@@ -3,8 +3,6 @@
 #ifndef VISITOR
 #define VISITOR
 
-#include "microRDB/Node.hpp"
-
 // forward declaration of every node type for visitor pattern
 namespace Node {
     struct Node;
@@ -16,6 +14,8 @@ namespace Node {
 
     struct Drop;
 
+    struct Analyze;
+
     struct Delete;
     struct Filter;
 
@@ -24,6 +24,9 @@ namespace Node {
     struct Assign;
 
     struct Insert;
+    struct BulkInsert;
+
+    struct Load;
     struct ExpressionList;
 
     struct OrExpression;
@@ -38,6 +41,7 @@ namespace Node {
     struct FloatLiteral;
     struct BoolLiteral;
     struct CharsLiteral;
+    struct Parameter;
 
     struct SelectExpression;
     struct ProjectExpression;
@@ -59,6 +63,8 @@ public:
 
     virtual void visit(const Node::Drop* n) = 0;
 
+    virtual void visit(const Node::Analyze* n) = 0;
+
     virtual void visit(const Node::Delete* n) = 0;
     virtual void visit(const Node::Filter* n) = 0;
 
@@ -67,6 +73,9 @@ public:
     virtual void visit(const Node::Assign* n) = 0;
 
     virtual void visit(const Node::Insert* n) = 0;
+    virtual void visit(const Node::BulkInsert* n) = 0;
+
+    virtual void visit(const Node::Load* n) = 0;
     virtual void visit(const Node::ExpressionList* n) = 0;
 
     virtual void visit(const Node::OrExpression* n) = 0;
@@ -81,6 +90,7 @@ public:
     virtual void visit(const Node::FloatLiteral* n) = 0;
     virtual void visit(const Node::BoolLiteral* n) = 0;
     virtual void visit(const Node::CharsLiteral* n) = 0;
+    virtual void visit(const Node::Parameter* n) = 0;
 
     virtual void visit(const Node::SelectExpression* n) = 0;
     virtual void visit(const Node::ProjectExpression* n) = 0;
@@ -0,0 +1,47 @@
+// WriteAheadLog.hpp
+
+#ifndef WRITEAHEADLOG
+#define WRITEAHEADLOG
+
+#include <string>
+#include <string_view>
+
+// redo log of the statements that changed the catalog, one record per statement
+// records are buffered and reach the file together with a commit marker in one write and one fsync
+// the file is itself a script, replaying it up to the last commit marker rebuilds the catalog
+class WriteAheadLog {
+private:
+    std::string path;
+    int fd = -1;
+
+    // records since the last commit
+    std::string pending;
+    size_t numPending = 0;
+
+    size_t numFlushes = 0;
+
+public:
+    static constexpr std::string_view commitMarker = "# commit\n";
+
+    explicit WriteAheadLog(const std::string& path);
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // committed statements of the log at path, a tail a crash left without its commit marker is cut off
+    // empty if there is no log yet
+    static std::string recover(const std::string& path);
+
+    // text of one statement, kept until the next commit
+    void append(const std::string& record);
+
+    // write the pending records followed by a commit marker, durable once it returns
+    // returns the number of records written, nothing is written when none are pending
+    size_t commit();
+
+    // commits that reached the file
+    size_t flushes() const { return numFlushes; }
+};
+
+#endif
@@ -0,0 +1,64 @@
+// Arena.cpp
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include "microRDB/Arena.hpp"
+
+void* Arena::allocate(size_t size, size_t alignment) {
+    size_t padding = (alignment - reinterpret_cast<uintptr_t>(next) % alignment) % alignment;
+    if (padding + size > remaining) {
+        // blocks double in size, so a large tree is freed in a handful of calls
+        size_t blockSize = std::max(nextBlockSize, size + alignment);
+        nextBlockSize = std::min(nextBlockSize * 2, maxBlockSize);
+        blocks.push_back(std::unique_ptr<char[]>(new char[blockSize]));
+        next = blocks.back().get();
+        remaining = blockSize;
+        padding = (alignment - reinterpret_cast<uintptr_t>(next) % alignment) % alignment;
+    }
+
+    void* result = next + padding;
+    next += padding + size;
+    remaining -= padding + size;
+    return result;
+}
+
+std::string_view Arena::copy(std::string_view text) {
+    if (text.empty()) {
+        return std::string_view();
+    }
+    char* data = makeArray<char>(text.size());
+    std::memcpy(data, text.data(), text.size());
+    return std::string_view(data, text.size());
+}
+
+const std::string& intern(std::string_view text) {
+    // every thread remembers the names it interned, so parser workers reading known names take no lock
+    thread_local std::unordered_map<std::string_view, const std::string*> seen;
+    auto known = seen.find(text);
+    if (known != seen.end()) {
+        return *known->second;
+    }
+
+    // a new name locks only the shard its hash picks, keys view the pooled strings
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string_view, std::unique_ptr<std::string>> strings;
+    };
+    static Shard shards[64];
+    Shard& shard = shards[std::hash<std::string_view>()(text) % 64];
+
+    const std::string* pooled;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.strings.find(text);
+        if (found == shard.strings.end()) {
+            auto string = std::make_unique<std::string>(text);
+            std::string_view key = *string;
+            found = shard.strings.emplace(key, std::move(string)).first;
+        }
+        pooled = found->second.get();
+    }
+    seen.emplace(*pooled, pooled);
+    return *pooled;
+}
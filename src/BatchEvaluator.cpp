@@ -0,0 +1,335 @@
+// BatchEvaluator.cpp
+
+#include <cmath>
+#include <iostream>
+#include "microRDB/BatchEvaluator.hpp"
+
+namespace {
+    void executionError(const std::string& message) {
+        std::cout << "Execution error. " << message << " Terminating.\n";
+        exit(1);
+    }
+
+    // numeric operand as a double, as the row-at-a-time evaluator reads it
+    double numericAt(const BatchEvaluator::Vector& v, size_t k) {
+        if (v.type == Value::intType) return v.ints[k];
+        if (v.type == Value::floatType) return v.floats[k];
+        return 0.0;
+    }
+
+    // out[k] is the operator applied to the three-way comparison of row k
+    template <typename Compare>
+    void compareEach(size_t n, Node::Operator op, Compare compare, std::vector<uint8_t>& out) {
+        switch (op) {
+            case Node::opEquals: for (size_t k = 0; k < n; ++k) out[k] = compare(k) == 0; break;
+            case Node::opNotEquals: for (size_t k = 0; k < n; ++k) out[k] = compare(k) != 0; break;
+            case Node::opLessThan: for (size_t k = 0; k < n; ++k) out[k] = compare(k) < 0; break;
+            case Node::opGreaterThan: for (size_t k = 0; k < n; ++k) out[k] = compare(k) > 0; break;
+            case Node::opLessThanOrEquals: for (size_t k = 0; k < n; ++k) out[k] = compare(k) <= 0; break;
+            default: for (size_t k = 0; k < n; ++k) out[k] = compare(k) >= 0; break;
+        }
+    }
+
+    template <typename T>
+    int threeWay(T l, T r) {
+        return (l > r) - (l < r);
+    }
+}
+
+BatchEvaluator::Vector BatchEvaluator::evaluate(const Node::Node* expr, const std::vector<uint32_t>& selected) {
+    return evaluateOn(expr, selected);
+}
+
+void BatchEvaluator::filter(const Node::Node* condition, std::vector<uint32_t>& selected) {
+    // the binder has checked that conditions are bools
+    Vector holds = evaluateOn(condition, selected);
+    size_t kept = 0;
+    for (size_t k = 0; k < selected.size(); ++k) {
+        selected[kept] = selected[k];
+        kept += holds.bools[k];
+    }
+    selected.resize(kept);
+}
+
+Value BatchEvaluator::valueAt(const Vector& vector, size_t k) {
+    switch (vector.type) {
+        case Value::intType: return Value(vector.ints[k]);
+        case Value::floatType: return Value(vector.floats[k]);
+        case Value::boolType: return Value(static_cast<bool>(vector.bools[k]));
+        case Value::charsType: return Value(std::string(vector.chars[k]));
+    }
+    return Value();
+}
+
+BatchEvaluator::Vector BatchEvaluator::evaluateOn(const Node::Node* expr, const std::vector<uint32_t>& rowsSelected) {
+    const std::vector<uint32_t>* outer = selection;
+    selection = &rowsSelected;
+    expr->accept(this);
+    selection = outer;
+
+    Vector values = std::move(result);
+    result = Vector();
+    return values;
+}
+
+void BatchEvaluator::broadcast(const Value& v) {
+    // chars are viewed, so v has to outlive the batch
+    size_t n = selection->size();
+    result.type = v.type;
+    switch (v.type) {
+        case Value::intType: result.ints.assign(n, v.intValue); break;
+        case Value::floatType: result.floats.assign(n, v.floatValue); break;
+        case Value::boolType: result.bools.assign(n, v.boolValue); break;
+        case Value::charsType: result.chars.assign(n, v.charsValue); break;
+    }
+}
+
+void BatchEvaluator::compare(const Node::Node* LHS, const Node::Node* RHS, Node::Operator op) {
+    Vector l = evaluateOn(LHS, *selection);
+    Vector r = evaluateOn(RHS, *selection);
+    size_t n = selection->size();
+    result.type = Value::boolType;
+    result.bools.resize(n);
+
+    // ints are promoted when compared with floats
+    if (l.type != r.type || l.type == Value::floatType) {
+        compareEach(n, op, [&](size_t k) { return threeWay(numericAt(l, k), numericAt(r, k)); }, result.bools);
+    }
+    else if (l.type == Value::intType) {
+        compareEach(n, op, [&](size_t k) { return threeWay(l.ints[k], r.ints[k]); }, result.bools);
+    }
+    else if (l.type == Value::boolType) {
+        compareEach(n, op, [&](size_t k) { return l.bools[k] - r.bools[k]; }, result.bools);
+    }
+    else {
+        compareEach(n, op, [&](size_t k) { return threeWay(l.chars[k].compare(r.chars[k]), 0); }, result.bools);
+    }
+}
+
+void BatchEvaluator::arithmetic(const Node::Node* LHS, const Node::Node* RHS, Node::Operator op) {
+    Vector l = evaluateOn(LHS, *selection);
+    Vector r = evaluateOn(RHS, *selection);
+    size_t n = selection->size();
+
+    if (l.type == Value::intType && r.type == Value::intType) {
+        if (op == Node::opDivide || op == Node::opModulus) {
+            for (size_t k = 0; k < n; ++k) {
+                if (r.ints[k] == 0) {
+                    executionError("Integer division by zero.");
+                }
+            }
+        }
+
+        // computed in 64 bits and truncated, like one row at a time
+        result.type = Value::intType;
+        result.ints.resize(n);
+        int* out = result.ints.data();
+        const int* a = l.ints.data();
+        const int* b = r.ints.data();
+        switch (op) {
+            case Node::opPlus: for (size_t k = 0; k < n; ++k) out[k] = static_cast<int>(static_cast<long long>(a[k]) + b[k]); break;
+            case Node::opMinus: for (size_t k = 0; k < n; ++k) out[k] = static_cast<int>(static_cast<long long>(a[k]) - b[k]); break;
+            case Node::opMultiply: for (size_t k = 0; k < n; ++k) out[k] = static_cast<int>(static_cast<long long>(a[k]) * b[k]); break;
+            case Node::opDivide: for (size_t k = 0; k < n; ++k) out[k] = static_cast<int>(static_cast<long long>(a[k]) / b[k]); break;
+            default: for (size_t k = 0; k < n; ++k) out[k] = static_cast<int>(static_cast<long long>(a[k]) % b[k]); break;
+        }
+        return;
+    }
+
+    // ints are promoted when combined with floats
+    std::vector<float> a(n);
+    std::vector<float> b(n);
+    for (size_t k = 0; k < n; ++k) {
+        a[k] = static_cast<float>(numericAt(l, k));
+        b[k] = static_cast<float>(numericAt(r, k));
+    }
+    result.type = Value::floatType;
+    result.floats.resize(n);
+    float* out = result.floats.data();
+    switch (op) {
+        case Node::opPlus: for (size_t k = 0; k < n; ++k) out[k] = a[k] + b[k]; break;
+        case Node::opMinus: for (size_t k = 0; k < n; ++k) out[k] = a[k] - b[k]; break;
+        case Node::opMultiply: for (size_t k = 0; k < n; ++k) out[k] = a[k] * b[k]; break;
+        case Node::opDivide: for (size_t k = 0; k < n; ++k) out[k] = a[k] / b[k]; break;
+        default: for (size_t k = 0; k < n; ++k) out[k] = std::fmod(a[k], b[k]); break;
+    }
+}
+
+void BatchEvaluator::logical(const Node::Node* LHS, const Node::Node* RHS, bool isAnd) {
+    Vector l = evaluateOn(LHS, *selection);
+
+    // the right side only runs for rows the left side leaves undecided, as with one row at a time
+    std::vector<uint32_t> undecided;
+    for (size_t k = 0; k < selection->size(); ++k) {
+        if (l.bools[k] == isAnd) {
+            undecided.push_back((*selection)[k]);
+        }
+    }
+    Vector r = evaluateOn(RHS, undecided);
+
+    result.type = Value::boolType;
+    result.bools = std::move(l.bools);
+    size_t j = 0;
+    for (auto& decided : result.bools) {
+        if (decided == isAnd) {
+            decided = r.bools[j++];
+        }
+    }
+}
+
+// only scalar expressions are evaluated in batches
+
+// visit script
+void BatchEvaluator::visit(const Node::Script* n) {}
+
+// visit create
+void BatchEvaluator::visit(const Node::Create* n) {}
+
+// visit name-type list
+void BatchEvaluator::visit(const Node::NameTypeList* n) {}
+
+// visit name-type pair
+void BatchEvaluator::visit(const Node::NameTypePair* n) {}
+
+// visit drop
+void BatchEvaluator::visit(const Node::Drop* n) {}
+
+// visit analyze
+void BatchEvaluator::visit(const Node::Analyze* n) {}
+
+// visit delete
+void BatchEvaluator::visit(const Node::Delete* n) {}
+
+// visit filter
+void BatchEvaluator::visit(const Node::Filter* n) {
+    n->expr->accept(this);
+}
+
+// visit update
+void BatchEvaluator::visit(const Node::Update* n) {}
+
+// visit assign list
+void BatchEvaluator::visit(const Node::AssignList* n) {}
+
+// visit assign
+void BatchEvaluator::visit(const Node::Assign* n) {
+    n->expr->accept(this);
+}
+
+// visit insert
+void BatchEvaluator::visit(const Node::Insert* n) {}
+
+// visit bulk insert
+void BatchEvaluator::visit(const Node::BulkInsert* n) {}
+
+// visit load
+void BatchEvaluator::visit(const Node::Load* n) {}
+
+// visit expression list
+void BatchEvaluator::visit(const Node::ExpressionList* n) {}
+
+// visit or expression
+void BatchEvaluator::visit(const Node::OrExpression* n) {
+    logical(n->LHS.get(), n->RHS.get(), false);
+}
+
+// visit and expression
+void BatchEvaluator::visit(const Node::AndExpression* n) {
+    logical(n->LHS.get(), n->RHS.get(), true);
+}
+
+// visit equality expression
+void BatchEvaluator::visit(const Node::EqualityExpression* n) {
+    compare(n->LHS.get(), n->RHS.get(), n->op);
+}
+
+// visit relational expression
+void BatchEvaluator::visit(const Node::RelationalExpression* n) {
+    compare(n->LHS.get(), n->RHS.get(), n->op);
+}
+
+// visit additive expression
+void BatchEvaluator::visit(const Node::AdditiveExpression* n) {
+    arithmetic(n->LHS.get(), n->RHS.get(), n->op);
+}
+
+// visit multiplicative expression
+void BatchEvaluator::visit(const Node::MultiplicativeExpression* n) {
+    arithmetic(n->LHS.get(), n->RHS.get(), n->op);
+}
+
+// visit identifier
+void BatchEvaluator::visit(const Node::Identifier* n) {
+    // column reference, gathered from the selected rows
+    size_t count = selection->size();
+    size_t ordinal = n->ordinal;
+    result.type = n->binding.type;
+    switch (result.type) {
+        case Value::intType:
+            result.ints.resize(count);
+            for (size_t k = 0; k < count; ++k) result.ints[k] = rows[(*selection)[k]][ordinal].intValue;
+            break;
+        case Value::floatType:
+            result.floats.resize(count);
+            for (size_t k = 0; k < count; ++k) result.floats[k] = rows[(*selection)[k]][ordinal].floatValue;
+            break;
+        case Value::boolType:
+            result.bools.resize(count);
+            for (size_t k = 0; k < count; ++k) result.bools[k] = rows[(*selection)[k]][ordinal].boolValue;
+            break;
+        case Value::charsType:
+            result.chars.resize(count);
+            for (size_t k = 0; k < count; ++k) result.chars[k] = rows[(*selection)[k]][ordinal].charsValue;
+            break;
+    }
+}
+
+// visit int literal
+void BatchEvaluator::visit(const Node::IntLiteral* n) {
+    broadcast(Value(n->value));
+}
+
+// visit float literal
+void BatchEvaluator::visit(const Node::FloatLiteral* n) {
+    broadcast(Value(n->value));
+}
+
+// visit bool literal
+void BatchEvaluator::visit(const Node::BoolLiteral* n) {
+    broadcast(Value(n->value));
+}
+
+// visit chars literal
+void BatchEvaluator::visit(const Node::CharsLiteral* n) {
+    // viewed in the tree's arena
+    result.type = Value::charsType;
+    result.chars.assign(selection->size(), n->value);
+}
+
+// visit parameter
+void BatchEvaluator::visit(const Node::Parameter* n) {
+    broadcast((*parameters)[n->index - 1]);
+}
+
+// select and project expressions are relational
+
+// visit select expression
+void BatchEvaluator::visit(const Node::SelectExpression* n) {}
+
+// visit project expression
+void BatchEvaluator::visit(const Node::ProjectExpression* n) {}
+
+// visit column list
+void BatchEvaluator::visit(const Node::ColumnList* n) {}
+
+// visit union expression
+void BatchEvaluator::visit(const Node::UnionExpression* n) {}
+
+// visit difference expression
+void BatchEvaluator::visit(const Node::DifferenceExpression* n) {}
+
+// visit intersect expression
+void BatchEvaluator::visit(const Node::IntersectExpression* n) {}
+
+// visit join expression
+void BatchEvaluator::visit(const Node::JoinExpression* n) {}
@@ -0,0 +1,389 @@
+// Binder.cpp
+
+#include <iostream>
+#include "microRDB/Binder.hpp"
+
+namespace {
+    bool isNumeric(Value::Type type) {
+        return type == Value::intType || type == Value::floatType;
+    }
+
+    // leaves of a ^ chain, parenthesized sub-chains included
+    void collectJoinLeaves(const Node::Node* n, std::vector<const Node::Node*>& leaves) {
+        const auto* join = dynamic_cast<const Node::JoinExpression*>(n);
+        if (join == nullptr) {
+            leaves.push_back(n);
+            return;
+        }
+        collectJoinLeaves(join->LHS.get(), leaves);
+        collectJoinLeaves(join->RHS.get(), leaves);
+    }
+}
+
+void Binder::semanticError(const std::string& message) const {
+    if (beforeError) {
+        beforeError();
+    }
+    std::cout << "Semantic error. " << message << " Terminating.\n";
+    exit(1);
+}
+
+const Table& Binder::lookupTable(const std::string& name) const {
+    if (beforeError && !catalog.contains(name)) {
+        beforeError();
+    }
+    return catalog.table(name);
+}
+
+void Binder::bindRelation(const Node::Node* expr) {
+    bool wasBindingScalar = bindingScalar;
+    bindingScalar = false;
+    expr->accept(this);
+    bindingScalar = wasBindingScalar;
+}
+
+const Node::Binding& Binder::bindScalar(const Node::Node* expr) {
+    bool wasBindingScalar = bindingScalar;
+    bindingScalar = true;
+    expr->accept(this);
+    bindingScalar = wasBindingScalar;
+    return expr->binding;
+}
+
+void Binder::bindCondition(const Node::Node* expr) {
+    Value::Type type = bindScalar(expr).type;
+    if (type != Value::boolType) {
+        semanticError("Expected a bool condition, got " + Value::typeName(type) + ".");
+    }
+}
+
+void Binder::checkStorable(const Node::Node* expr, const Column& column) {
+    Value::Type type = expr->binding.type;
+    if (type != column.type && !(column.type == Value::floatType && type == Value::intType)) {
+        semanticError("Cannot store " + Value::typeName(type) + " in " + Value::typeName(column.type)
+                      + " column \"" + column.name + "\".");
+    }
+}
+
+void Binder::checkWritable(const std::string& tableName) {
+    if (catalog.isMaintained(tableName)) {
+        semanticError("Table \"" + tableName + "\" is maintained from its definition and cannot be modified directly.");
+    }
+}
+
+// visit script
+void Binder::visit(const Node::Script* n) {
+    for (const auto& statement : n->statements) {
+        statement->accept(this);
+    }
+}
+
+// visit create
+void Binder::visit(const Node::Create* n) {
+    bindRelation(n->expression.get());
+}
+
+// visit name-type list
+void Binder::visit(const Node::NameTypeList* n) {}
+
+// visit name-type pair
+void Binder::visit(const Node::NameTypePair* n) {}
+
+// visit drop
+void Binder::visit(const Node::Drop* n) {
+    std::vector<std::string> readers = catalog.maintainedReaders(n->tableName);
+    if (!readers.empty()) {
+        semanticError("Table \"" + n->tableName + "\" is read by maintained table \"" + readers.front() + "\".");
+    }
+}
+
+// visit analyze
+void Binder::visit(const Node::Analyze* n) {}
+
+// visit delete
+void Binder::visit(const Node::Delete* n) {
+    const Table& table = lookupTable(n->tableName);
+    checkWritable(n->tableName);
+    rowSchema = &table;
+    for (const auto& filter : n->filters) {
+        filter->accept(this);
+    }
+    rowSchema = nullptr;
+}
+
+// visit filter
+void Binder::visit(const Node::Filter* n) {
+    bindCondition(n->expr.get());
+}
+
+// visit update
+void Binder::visit(const Node::Update* n) {
+    const Table& table = lookupTable(n->tableName);
+    checkWritable(n->tableName);
+    rowSchema = &table;
+    for (const auto& filter : n->filters) {
+        filter->accept(this);
+    }
+    n->assignList->accept(this);
+    rowSchema = nullptr;
+}
+
+// visit assign list
+void Binder::visit(const Node::AssignList* n) {
+    for (const auto& assign : n->assigns) {
+        assign->accept(this);
+    }
+}
+
+// visit assign
+void Binder::visit(const Node::Assign* n) {
+    int index = rowSchema->columnIndex(n->name);
+    if (index == -1) {
+        semanticError("Unknown column \"" + n->name + "\".");
+    }
+    n->ordinal = index;
+
+    bindScalar(n->expr.get());
+    checkStorable(n->expr.get(), rowSchema->columns[index]);
+}
+
+// visit insert
+void Binder::visit(const Node::Insert* n) {
+    const Table& table = lookupTable(n->tableName);
+    checkWritable(n->tableName);
+    for (const auto& expressionList : n->expressionLists) {
+        const auto* list = static_cast<const Node::ExpressionList*>(expressionList.get());
+        if (list->expressions.size() != table.columns.size()) {
+            semanticError("Table \"" + n->tableName + "\" has " + std::to_string(table.columns.size())
+                          + " columns, but " + std::to_string(list->expressions.size()) + " values were given.");
+        }
+        list->accept(this);
+        for (size_t i = 0; i < list->expressions.size(); ++i) {
+            checkStorable(list->expressions[i].get(), table.columns[i]);
+        }
+    }
+}
+
+// visit bulk insert
+// literals are checked against the schema by the executor, which converts them in the same pass
+void Binder::visit(const Node::BulkInsert* n) {
+    lookupTable(n->tableName);
+    checkWritable(n->tableName);
+}
+
+// visit load
+void Binder::visit(const Node::Load* n) {
+    lookupTable(n->tableName);
+    checkWritable(n->tableName);
+}
+
+// visit expression list
+void Binder::visit(const Node::ExpressionList* n) {
+    for (const auto& expr : n->expressions) {
+        bindScalar(expr.get());
+    }
+}
+
+// visit or expression
+void Binder::visit(const Node::OrExpression* n) {
+    bindCondition(n->LHS.get());
+    bindCondition(n->RHS.get());
+    n->binding = Node::Binding{Value::boolType, 0};
+}
+
+// visit and expression
+void Binder::visit(const Node::AndExpression* n) {
+    bindCondition(n->LHS.get());
+    bindCondition(n->RHS.get());
+    n->binding = Node::Binding{Value::boolType, 0};
+}
+
+// visit equality expression
+void Binder::visit(const Node::EqualityExpression* n) {
+    Value::Type lhs = bindScalar(n->LHS.get()).type;
+    Value::Type rhs = bindScalar(n->RHS.get()).type;
+    if (lhs != rhs && !(isNumeric(lhs) && isNumeric(rhs))) {
+        semanticError("Cannot compare " + Value::typeName(lhs) + " with " + Value::typeName(rhs) + ".");
+    }
+    n->binding = Node::Binding{Value::boolType, 0};
+}
+
+// visit relational expression
+void Binder::visit(const Node::RelationalExpression* n) {
+    Value::Type lhs = bindScalar(n->LHS.get()).type;
+    Value::Type rhs = bindScalar(n->RHS.get()).type;
+    if (lhs != rhs && !(isNumeric(lhs) && isNumeric(rhs))) {
+        semanticError("Cannot compare " + Value::typeName(lhs) + " with " + Value::typeName(rhs) + ".");
+    }
+    n->binding = Node::Binding{Value::boolType, 0};
+}
+
+// visit additive expression
+void Binder::visit(const Node::AdditiveExpression* n) {
+    Value::Type lhs = bindScalar(n->LHS.get()).type;
+    Value::Type rhs = bindScalar(n->RHS.get()).type;
+    if (!isNumeric(lhs) || !isNumeric(rhs)) {
+        semanticError(std::string("Operator ") + Node::operatorString(n->op) + " expects numeric operands, got "
+                      + Value::typeName(lhs) + " and " + Value::typeName(rhs) + ".");
+    }
+
+    // int op int stays int, anything with a float is promoted
+    bool bothInt = lhs == Value::intType && rhs == Value::intType;
+    n->binding = Node::Binding{bothInt ? Value::intType : Value::floatType, 0};
+}
+
+// visit multiplicative expression
+void Binder::visit(const Node::MultiplicativeExpression* n) {
+    Value::Type lhs = bindScalar(n->LHS.get()).type;
+    Value::Type rhs = bindScalar(n->RHS.get()).type;
+    if (n->op == Node::opModulus && (lhs != Value::intType || rhs != Value::intType)) {
+        semanticError("Operator % expects int operands.");
+    }
+    if (!isNumeric(lhs) || !isNumeric(rhs)) {
+        semanticError(std::string("Operator ") + Node::operatorString(n->op) + " expects numeric operands, got "
+                      + Value::typeName(lhs) + " and " + Value::typeName(rhs) + ".");
+    }
+
+    bool bothInt = lhs == Value::intType && rhs == Value::intType;
+    n->binding = Node::Binding{bothInt ? Value::intType : Value::floatType, 0};
+}
+
+// visit identifier
+void Binder::visit(const Node::Identifier* n) {
+    // column reference
+    if (bindingScalar) {
+        if (rowSchema == nullptr) {
+            semanticError("Column reference \"" + n->name + "\" outside of a filter or assignment.");
+        }
+        int index = rowSchema->columnIndex(n->name);
+        if (index == -1) {
+            semanticError("Unknown column \"" + n->name + "\".");
+        }
+        const Column& column = rowSchema->columns[index];
+        n->ordinal = index;
+        n->binding = Node::Binding{column.type, column.numChars};
+        return;
+    }
+
+    // table reference
+    schema = Table();
+    schema.columns = lookupTable(n->name).columns;
+}
+
+// visit int literal
+void Binder::visit(const Node::IntLiteral* n) {
+    n->binding = Node::Binding{Value::intType, 0};
+}
+
+// visit float literal
+void Binder::visit(const Node::FloatLiteral* n) {
+    n->binding = Node::Binding{Value::floatType, 0};
+}
+
+// visit bool literal
+void Binder::visit(const Node::BoolLiteral* n) {
+    n->binding = Node::Binding{Value::boolType, 0};
+}
+
+// visit chars literal
+void Binder::visit(const Node::CharsLiteral* n) {
+    n->binding = Node::Binding{Value::charsType, n->value.size()};
+}
+
+// visit parameter
+void Binder::visit(const Node::Parameter* n) {
+    if (parameters == nullptr || size_t(n->index) > parameters->size()) {
+        semanticError("Parameter $" + std::to_string(n->index) + " has no value.");
+    }
+    const Value& parameter = (*parameters)[n->index - 1];
+    n->binding = Node::Binding{parameter.type, parameter.type == Value::charsType ? parameter.charsValue.size() : 0};
+}
+
+// visit select expression
+void Binder::visit(const Node::SelectExpression* n) {
+    bindRelation(n->LHS.get());
+    Table input = std::move(schema);
+
+    // the predicate sees the columns of its input
+    const Table* outerRowSchema = rowSchema;
+    rowSchema = &input;
+    bindCondition(n->RHS.get());
+    rowSchema = outerRowSchema;
+
+    schema = std::move(input);
+}
+
+// visit project expression
+void Binder::visit(const Node::ProjectExpression* n) {
+    bindRelation(n->LHS.get());
+    n->RHS->accept(this);
+}
+
+// visit column list
+void Binder::visit(const Node::ColumnList* n) {
+    // projects the current schema
+    Table projected;
+    for (const auto& column : n->columns) {
+        int index = schema.columnIndex(column->name);
+        if (index == -1) {
+            semanticError("Unknown column \"" + column->name + "\" in projection.");
+        }
+        projected.columns.push_back(schema.columns[index]);
+    }
+    schema = std::move(projected);
+}
+
+// visit union expression
+void Binder::visit(const Node::UnionExpression* n) {
+    bindRelation(n->LHS.get());
+    Table left = std::move(schema);
+    bindRelation(n->RHS.get());
+    if (!left.isUnionCompatible(schema)) {
+        semanticError("Operands of | are not union compatible.");
+    }
+    schema = std::move(left);
+}
+
+// visit difference expression
+void Binder::visit(const Node::DifferenceExpression* n) {
+    bindRelation(n->LHS.get());
+    Table left = std::move(schema);
+    bindRelation(n->RHS.get());
+    if (!left.isUnionCompatible(schema)) {
+        semanticError("Operands of - are not union compatible.");
+    }
+    schema = std::move(left);
+}
+
+// visit intersect expression
+void Binder::visit(const Node::IntersectExpression* n) {
+    bindRelation(n->LHS.get());
+    Table left = std::move(schema);
+    bindRelation(n->RHS.get());
+    if (!left.isUnionCompatible(schema)) {
+        semanticError("Operands of & are not union compatible.");
+    }
+    schema = std::move(left);
+}
+
+// visit join expression
+void Binder::visit(const Node::JoinExpression* n) {
+    // natural join over the whole ^ chain, columns in the order the textual left-deep chain produces them
+    std::vector<const Node::Node*> leaves;
+    collectJoinLeaves(n, leaves);
+
+    Table joined;
+    for (const auto* leaf : leaves) {
+        bindRelation(leaf);
+        for (const auto& column : schema.columns) {
+            int index = joined.columnIndex(column.name);
+            if (index == -1) {
+                joined.columns.push_back(column);
+            }
+            else if (joined.columns[index].type != column.type) {
+                semanticError("Join column \"" + column.name + "\" has mismatched types.");
+            }
+        }
+    }
+    schema = std::move(joined);
+}
@@ -0,0 +1,37 @@
+// BloomFilter.cpp
+
+#include <algorithm>
+#include "microRDB/BloomFilter.hpp"
+
+namespace {
+    // bits of a rehash pick the bit in each word, the original hash picks the block
+    constexpr uint64_t bitSalt = 0x9e3779b97f4a7c15ULL;
+}
+
+BloomFilter::BloomFilter(size_t expectedKeys, size_t bitsPerKey) {
+    size_t bits = std::max<size_t>(expectedKeys, 1) * bitsPerKey;
+    blocks.resize((bits + 511) / 512);
+}
+
+const BloomFilter::Block& BloomFilter::blockOf(uint64_t hash) const {
+    // multiply-shift range reduction of the high half
+    return blocks[((hash >> 32) * blocks.size()) >> 32];
+}
+
+void BloomFilter::add(uint64_t hash) {
+    Block& block = const_cast<Block&>(blockOf(hash));
+    uint64_t bits = hash * bitSalt;
+    for (size_t i = 0; i < 8; ++i) {
+        block.words[i] |= uint64_t(1) << ((bits >> (6 * i)) & 63);
+    }
+}
+
+bool BloomFilter::mayContain(uint64_t hash) const {
+    const Block& block = blockOf(hash);
+    uint64_t bits = hash * bitSalt;
+    bool contained = true;
+    for (size_t i = 0; i < 8; ++i) {
+        contained &= (block.words[i] >> ((bits >> (6 * i)) & 63)) & 1;
+    }
+    return contained;
+}
@@ -0,0 +1,328 @@
+// BulkLoader.cpp
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "microRDB/BulkLoader.hpp"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+    void loadError(const std::string& message) {
+        std::cout << "Load error. " << message << " Terminating.\n";
+        exit(1);
+    }
+
+    // read only mapping of a whole file, unmapped on destruction
+    struct MappedFile {
+        const char* data = nullptr;
+        size_t size = 0;
+
+        explicit MappedFile(const std::string& path) {
+            int fd = open(path.c_str(), O_RDONLY);
+            struct stat status;
+            if (fd == -1 || fstat(fd, &status) == -1) {
+                loadError("Could not open \"" + path + "\".");
+            }
+
+            // an empty file cannot be mapped
+            size = status.st_size;
+            if (size > 0) {
+                void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (address == MAP_FAILED) {
+                    loadError("Could not map \"" + path + "\".");
+                }
+                data = static_cast<const char*>(address);
+                madvise(address, size, MADV_WILLNEED);
+            }
+            close(fd);
+        }
+
+        ~MappedFile() {
+            if (data != nullptr) {
+                munmap(const_cast<char*>(data), size);
+            }
+        }
+    };
+
+    bool endsWith(const std::string& text, const std::string& suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // next ',' or '\n' in [i, end), or end
+    // fields are short, so one block compare usually finds the delimiter
+    size_t findDelimiter(const char* text, size_t i, size_t end) {
+#if defined(__AVX2__)
+        const __m256i commas = _mm256_set1_epi8(',');
+        const __m256i newlines = _mm256_set1_epi8('\n');
+        for (; i + 32 <= end; i += 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+            uint32_t stops = uint32_t(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(block, commas),
+                                                                           _mm256_cmpeq_epi8(block, newlines))));
+            if (stops != 0) {
+                return i + __builtin_ctz(stops);
+            }
+        }
+#elif defined(__SSE2__)
+        const __m128i commas = _mm_set1_epi8(',');
+        const __m128i newlines = _mm_set1_epi8('\n');
+        for (; i + 16 <= end; i += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+            uint32_t stops = uint32_t(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, commas),
+                                                                     _mm_cmpeq_epi8(block, newlines))));
+            if (stops != 0) {
+                return i + __builtin_ctz(stops);
+            }
+        }
+#endif
+        while (i < end && text[i] != ',' && text[i] != '\n') {
+            ++i;
+        }
+        return i;
+    }
+
+    // start of the first record at or after offset, records start at 0 or after a '\n'
+    size_t recordStart(std::string_view text, size_t offset) {
+        if (offset == 0 || offset >= text.size()) {
+            return std::min(offset, text.size());
+        }
+        const void* newline = memchr(text.data() + offset - 1, '\n', text.size() - offset + 1);
+        return newline == nullptr ? text.size() : static_cast<const char*>(newline) - text.data() + 1;
+    }
+
+    // convert one field per its column, false with a message if it does not fit
+    bool convert(std::string_view field, const Column& column, Row& row, std::string& message) {
+        const char* first = field.data();
+        const char* last = field.data() + field.size();
+        switch (column.type) {
+            case Value::intType: {
+                int value = 0;
+                auto result = std::from_chars(first, last, value);
+                if (field.empty() || result.ec != std::errc() || result.ptr != last) {
+                    message = "\"" + std::string(field) + "\" is not an int for column \"" + column.name + "\".";
+                    return false;
+                }
+                row.push_back(Value(value));
+                return true;
+            }
+            case Value::floatType: {
+                // through double like the lexer, so loaded and inserted floats round the same
+                double value = 0.0;
+                auto result = std::from_chars(first, last, value);
+                if (field.empty() || result.ec != std::errc() || result.ptr != last) {
+                    message = "\"" + std::string(field) + "\" is not a float for column \"" + column.name + "\".";
+                    return false;
+                }
+                row.push_back(Value(static_cast<float>(value)));
+                return true;
+            }
+            case Value::boolType: {
+                if (field != "true" && field != "false") {
+                    message = "\"" + std::string(field) + "\" is not a bool for column \"" + column.name + "\".";
+                    return false;
+                }
+                row.push_back(Value(field == "true"));
+                return true;
+            }
+            case Value::charsType: {
+                if (field.size() > column.numChars) {
+                    message = "Value \"" + std::string(field) + "\" is longer than chars " + std::to_string(column.numChars)
+                              + " column \"" + column.name + "\".";
+                    return false;
+                }
+                row.push_back(Value(std::string(field)));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // bytes a column takes in a binary record
+    size_t binaryWidth(const Column& column) {
+        switch (column.type) {
+            case Value::intType: return sizeof(int);
+            case Value::floatType: return sizeof(float);
+            case Value::boolType: return 1;
+            case Value::charsType: return column.numChars;
+        }
+        return 0;
+    }
+}
+
+std::vector<Row> BulkLoader::load(const std::string& path, const std::vector<Column>& columns) const {
+    MappedFile file(path);
+    std::string_view text(file.data, file.size);
+
+    std::vector<Row> rows;
+    if (endsWith(path, ".bin")) {
+        loadBinary(text, columns, rows);
+    }
+    else {
+        loadCsv(text, columns, rows);
+    }
+
+    return rows;
+}
+
+void BulkLoader::loadCsv(std::string_view text, const std::vector<Column>& columns, std::vector<Row>& rows) const {
+    // skip a header line that names the columns in order
+    size_t begin = 0;
+    std::string_view firstLine = text.substr(0, text.find('\n'));
+    if (!firstLine.empty() && firstLine.back() == '\r') {
+        firstLine.remove_suffix(1);
+    }
+    std::string header;
+    for (size_t c = 0; c < columns.size(); ++c) {
+        header += (c > 0 ? "," : "") + columns[c].name;
+    }
+    if (firstLine == header) {
+        begin = recordStart(text, firstLine.size() + 1);
+    }
+
+    // chunks own the records that start inside them
+    std::vector<size_t> bounds = {begin};
+    for (size_t offset = begin + chunkSize; offset < text.size(); offset += chunkSize) {
+        size_t start = recordStart(text, offset);
+        if (start > bounds.back()) {
+            bounds.push_back(start);
+        }
+    }
+    bounds.push_back(text.size());
+
+    size_t numChunks = bounds.size() - 1;
+    std::vector<std::vector<Row>> chunkRows(numChunks);
+    std::vector<LoadError> errors(numChunks);
+    pool.parallelFor(numChunks, 1, [&](size_t m, size_t, size_t) {
+        parseCsvChunk(text, bounds[m], bounds[m + 1], columns, chunkRows[m], errors[m]);
+    });
+
+    // the earliest malformed field in the file
+    for (const auto& error : errors) {
+        if (error.offset != std::string_view::npos) {
+            size_t line = 1 + std::count(text.begin(), text.begin() + error.offset, '\n');
+            loadError("Line " + std::to_string(line) + ": " + error.message);
+        }
+    }
+
+    // whole chunks are appended in file order
+    size_t total = 0;
+    for (const auto& chunk : chunkRows) {
+        total += chunk.size();
+    }
+    rows.reserve(total);
+    for (auto& chunk : chunkRows) {
+        rows.insert(rows.end(), std::make_move_iterator(chunk.begin()), std::make_move_iterator(chunk.end()));
+    }
+}
+
+void BulkLoader::parseCsvChunk(std::string_view text, size_t begin, size_t end, const std::vector<Column>& columns,
+                               std::vector<Row>& rows, LoadError& error) const {
+    const char* data = text.data();
+    size_t i = begin;
+    while (i < end) {
+        // blank lines
+        if (data[i] == '\n' || (data[i] == '\r' && i + 1 < end && data[i + 1] == '\n')) {
+            i += data[i] == '\r' ? 2 : 1;
+            continue;
+        }
+
+        Row row;
+        row.reserve(columns.size());
+        for (size_t c = 0; c < columns.size(); ++c) {
+            size_t fieldStart = i;
+            std::string_view field;
+            if (i < end && data[i] == '\"') {
+                const void* quote = memchr(data + i + 1, '\"', end - i - 1);
+                if (quote == nullptr) {
+                    error = {fieldStart, "Unpaired \" in a field."};
+                    return;
+                }
+                size_t close = static_cast<const char*>(quote) - data;
+                field = text.substr(i + 1, close - i - 1);
+                i = close + 1;
+            }
+            else {
+                size_t delimiter = findDelimiter(data, i, end);
+                field = text.substr(i, delimiter - i);
+                i = delimiter;
+            }
+
+            // CRLF line ends, the \r is either the end of an unquoted field or follows the closing quote
+            bool last = c + 1 == columns.size();
+            if (last && i < end && data[i] == '\r') {
+                ++i;
+            }
+            else if (last && !field.empty() && field.back() == '\r' && data[fieldStart] != '\"') {
+                field.remove_suffix(1);
+            }
+
+            // a comma between fields, a newline or the end of the chunk after the last one
+            char expected = last ? '\n' : ',';
+            if ((i < end && data[i] != expected) || (i == end && !last)) {
+                error = {fieldStart, "Expected " + std::to_string(columns.size()) + " fields per record."};
+                return;
+            }
+            ++i;
+
+            std::string message;
+            if (!convert(field, columns[c], row, message)) {
+                error = {fieldStart, message};
+                return;
+            }
+        }
+        rows.push_back(std::move(row));
+    }
+}
+
+void BulkLoader::loadBinary(std::string_view text, const std::vector<Column>& columns, std::vector<Row>& rows) const {
+    size_t recordSize = 0;
+    for (const auto& column : columns) {
+        recordSize += binaryWidth(column);
+    }
+    if (recordSize == 0 || text.size() % recordSize != 0) {
+        loadError("Binary file size " + std::to_string(text.size()) + " is not a multiple of the "
+                  + std::to_string(recordSize) + " byte record size.");
+    }
+
+    size_t numRecords = text.size() / recordSize;
+    rows.resize(numRecords);
+    size_t recordsPerChunk = std::max<size_t>(1, chunkSize / recordSize);
+    pool.parallelFor(numRecords, recordsPerChunk, [&](size_t, size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            const char* field = text.data() + r * recordSize;
+            Row& row = rows[r];
+            row.reserve(columns.size());
+            for (const auto& column : columns) {
+                switch (column.type) {
+                    case Value::intType: {
+                        int value;
+                        memcpy(&value, field, sizeof(value));
+                        row.push_back(Value(value));
+                        break;
+                    }
+                    case Value::floatType: {
+                        float value;
+                        memcpy(&value, field, sizeof(value));
+                        row.push_back(Value(value));
+                        break;
+                    }
+                    case Value::boolType:
+                        row.push_back(Value(*field != 0));
+                        break;
+                    case Value::charsType:
+                        row.push_back(Value(std::string(field, strnlen(field, column.numChars))));
+                        break;
+                }
+                field += binaryWidth(column);
+            }
+        }
+    });
+}
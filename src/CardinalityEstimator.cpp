@@ -0,0 +1,384 @@
+// CardinalityEstimator.cpp
+
+#include <algorithm>
+#include "microRDB/Node.hpp"
+#include "microRDB/CardinalityEstimator.hpp"
+
+namespace {
+    // System R style defaults when statistics cannot answer
+    constexpr double defaultEqualitySelectivity = 0.1;
+    constexpr double defaultRangeSelectivity = 1.0 / 3.0;
+
+    Node::Operator flip(Node::Operator op) {
+        if (op == Node::opLessThan) return Node::opGreaterThan;
+        if (op == Node::opGreaterThan) return Node::opLessThan;
+        if (op == Node::opLessThanOrEquals) return Node::opGreaterThanOrEquals;
+        if (op == Node::opGreaterThanOrEquals) return Node::opLessThanOrEquals;
+        return op;
+    }
+
+    void clampDistinct(RelationEstimate& estimate) {
+        for (auto& d : estimate.distinct) {
+            d = std::min(d, estimate.rows);
+        }
+    }
+}
+
+int RelationEstimate::columnIndex(const std::string& name) const {
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (columns[i] == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+RelationEstimate CardinalityEstimator::estimateRelation(const Node::Node* expr) {
+    estimate = RelationEstimate();
+    expr->accept(this);
+    return estimate;
+}
+
+double CardinalityEstimator::estimateSelectivity(const Node::Node* predicate, const RelationEstimate& in) {
+    const RelationEstimate* outerInput = input;
+    input = &in;
+    visitScalar(predicate);
+    input = outerInput;
+    return std::max(0.0, std::min(1.0, selectivity));
+}
+
+RelationEstimate CardinalityEstimator::estimateJoin(const RelationEstimate& left, const RelationEstimate& right) {
+    RelationEstimate output = left;
+    output.rows = left.rows * right.rows;
+
+    // natural join: each shared column divides by the larger distinct count
+    for (size_t r = 0; r < right.columns.size(); ++r) {
+        int l = left.columnIndex(right.columns[r]);
+        if (l == -1) {
+            output.columns.push_back(right.columns[r]);
+            output.distinct.push_back(right.distinct[r]);
+            output.statistics.push_back(right.statistics[r]);
+            continue;
+        }
+
+        double larger = std::max(left.distinct[l], right.distinct[r]);
+        if (larger > 0.0) {
+            output.rows /= larger;
+        }
+        output.distinct[l] = std::min(left.distinct[l], right.distinct[r]);
+    }
+
+    clampDistinct(output);
+    return output;
+}
+
+void CardinalityEstimator::visitScalar(const Node::Node* expr) {
+    bool wasEvaluatingScalar = evaluatingScalar;
+    evaluatingScalar = true;
+    operandKind = otherOperand;
+    selectivity = defaultRangeSelectivity;
+    expr->accept(this);
+    evaluatingScalar = wasEvaluatingScalar;
+}
+
+double CardinalityEstimator::comparisonSelectivity(const Node::Node* LHS, const Node::Node* RHS, Node::Operator op) {
+    visitScalar(LHS);
+    OperandKind leftKind = operandKind;
+    int leftColumn = operandColumn;
+    double leftLiteral = operandLiteral;
+    bool leftIsNumeric = operandIsNumeric;
+
+    visitScalar(RHS);
+    OperandKind rightKind = operandKind;
+    int rightColumn = operandColumn;
+    double rightLiteral = operandLiteral;
+    bool rightIsNumeric = operandIsNumeric;
+
+    bool isEquality = op == Node::opEquals || op == Node::opNotEquals;
+
+    // column against column
+    if (leftKind == columnOperand && rightKind == columnOperand) {
+        if (!isEquality) {
+            return defaultRangeSelectivity;
+        }
+        double larger = std::max(input->distinct[leftColumn], input->distinct[rightColumn]);
+        double equal = larger > 0.0 ? 1.0 / larger : defaultEqualitySelectivity;
+        return op == Node::opEquals ? equal : 1.0 - equal;
+    }
+
+    // normalize to column op literal
+    Node::Operator normalized = op;
+    int column = leftColumn;
+    double literal = rightLiteral;
+    bool literalIsNumeric = rightIsNumeric;
+    if (leftKind == literalOperand && rightKind == columnOperand) {
+        normalized = flip(op);
+        column = rightColumn;
+        literal = leftLiteral;
+        literalIsNumeric = leftIsNumeric;
+    }
+    else if (!(leftKind == columnOperand && rightKind == literalOperand)) {
+        return isEquality ? defaultEqualitySelectivity : defaultRangeSelectivity;
+    }
+
+    if (isEquality) {
+        double distinct = input->distinct[column];
+        double equal = distinct > 0.0 ? 1.0 / distinct : defaultEqualitySelectivity;
+        return normalized == Node::opEquals ? equal : 1.0 - equal;
+    }
+
+    const ColumnStatistics* statistics = input->statistics[column];
+    if (statistics == nullptr || !statistics->hasHistogram || statistics->histogram.empty() || !literalIsNumeric) {
+        return defaultRangeSelectivity;
+    }
+
+    const EquiDepthHistogram& histogram = statistics->histogram;
+    if (normalized == Node::opLessThan) return histogram.fractionBelow(literal, false);
+    if (normalized == Node::opLessThanOrEquals) return histogram.fractionBelow(literal, true);
+    if (normalized == Node::opGreaterThan) return 1.0 - histogram.fractionBelow(literal, true);
+    return 1.0 - histogram.fractionBelow(literal, false);
+}
+
+// visit script
+void CardinalityEstimator::visit(const Node::Script* n) {}
+
+// visit create
+void CardinalityEstimator::visit(const Node::Create* n) {}
+
+// visit name-type list
+void CardinalityEstimator::visit(const Node::NameTypeList* n) {}
+
+// visit name-type pair
+void CardinalityEstimator::visit(const Node::NameTypePair* n) {}
+
+// visit drop
+void CardinalityEstimator::visit(const Node::Drop* n) {}
+
+// visit analyze
+void CardinalityEstimator::visit(const Node::Analyze* n) {}
+
+// visit delete
+void CardinalityEstimator::visit(const Node::Delete* n) {}
+
+// visit filter
+void CardinalityEstimator::visit(const Node::Filter* n) {
+    visitScalar(n->expr.get());
+}
+
+// visit update
+void CardinalityEstimator::visit(const Node::Update* n) {}
+
+// visit assign list
+void CardinalityEstimator::visit(const Node::AssignList* n) {}
+
+// visit assign
+void CardinalityEstimator::visit(const Node::Assign* n) {}
+
+// visit insert
+void CardinalityEstimator::visit(const Node::Insert* n) {}
+
+// visit bulk insert
+void CardinalityEstimator::visit(const Node::BulkInsert* n) {}
+
+// visit load
+void CardinalityEstimator::visit(const Node::Load* n) {}
+
+// visit expression list
+void CardinalityEstimator::visit(const Node::ExpressionList* n) {}
+
+// visit or expression
+void CardinalityEstimator::visit(const Node::OrExpression* n) {
+    visitScalar(n->LHS.get());
+    double left = selectivity;
+    visitScalar(n->RHS.get());
+    double right = selectivity;
+
+    selectivity = left + right - left * right;
+    operandKind = otherOperand;
+}
+
+// visit and expression
+void CardinalityEstimator::visit(const Node::AndExpression* n) {
+    // independence assumption
+    visitScalar(n->LHS.get());
+    double left = selectivity;
+    visitScalar(n->RHS.get());
+    double right = selectivity;
+
+    selectivity = left * right;
+    operandKind = otherOperand;
+}
+
+// visit equality expression
+void CardinalityEstimator::visit(const Node::EqualityExpression* n) {
+    selectivity = comparisonSelectivity(n->LHS.get(), n->RHS.get(), n->op);
+    operandKind = otherOperand;
+}
+
+// visit relational expression
+void CardinalityEstimator::visit(const Node::RelationalExpression* n) {
+    selectivity = comparisonSelectivity(n->LHS.get(), n->RHS.get(), n->op);
+    operandKind = otherOperand;
+}
+
+// visit additive expression
+void CardinalityEstimator::visit(const Node::AdditiveExpression* n) {
+    selectivity = defaultRangeSelectivity;
+    operandKind = otherOperand;
+}
+
+// visit multiplicative expression
+void CardinalityEstimator::visit(const Node::MultiplicativeExpression* n) {
+    selectivity = defaultRangeSelectivity;
+    operandKind = otherOperand;
+}
+
+// visit identifier
+void CardinalityEstimator::visit(const Node::Identifier* n) {
+    // column reference
+    if (evaluatingScalar) {
+        operandColumn = input == nullptr ? -1 : input->columnIndex(n->name);
+        operandKind = operandColumn == -1 ? otherOperand : columnOperand;
+
+        // a bare bool column used as a predicate
+        selectivity = 0.5;
+        if (operandKind == columnOperand) {
+            const ColumnStatistics* statistics = input->statistics[operandColumn];
+            if (statistics != nullptr && statistics->hasHistogram && !statistics->histogram.empty()) {
+                selectivity = 1.0 - statistics->histogram.fractionBelow(1.0, false);
+            }
+        }
+        return;
+    }
+
+    // table reference
+    estimate = RelationEstimate();
+    if (!catalog.contains(n->name)) {
+        return;
+    }
+
+    const Table& table = catalog.table(n->name);
+    const TableStatistics& statistics = catalog.tableStatistics(n->name);
+    estimate.rows = statistics.rowCount;
+    for (size_t c = 0; c < table.columns.size(); ++c) {
+        estimate.columns.push_back(table.columns[c].name);
+        estimate.distinct.push_back(statistics.distinctValues(c));
+        estimate.statistics.push_back(c < statistics.columns.size() ? &statistics.columns[c] : nullptr);
+    }
+}
+
+// visit int literal
+void CardinalityEstimator::visit(const Node::IntLiteral* n) {
+    operandKind = literalOperand;
+    operandLiteral = n->value;
+    operandIsNumeric = true;
+}
+
+// visit float literal
+void CardinalityEstimator::visit(const Node::FloatLiteral* n) {
+    operandKind = literalOperand;
+    operandLiteral = n->value;
+    operandIsNumeric = true;
+}
+
+// visit bool literal
+void CardinalityEstimator::visit(const Node::BoolLiteral* n) {
+    operandKind = literalOperand;
+    operandLiteral = n->value ? 1.0 : 0.0;
+    operandIsNumeric = true;
+    selectivity = n->value ? 1.0 : 0.0;
+}
+
+// visit chars literal
+void CardinalityEstimator::visit(const Node::CharsLiteral* n) {
+    operandKind = literalOperand;
+    operandLiteral = 0.0;
+    operandIsNumeric = false;
+}
+
+// visit parameter
+// its value is unknown when a cached plan is made, so it is estimated like a non-numeric literal
+void CardinalityEstimator::visit(const Node::Parameter* n) {
+    operandKind = literalOperand;
+    operandLiteral = 0.0;
+    operandIsNumeric = false;
+}
+
+// visit select expression
+void CardinalityEstimator::visit(const Node::SelectExpression* n) {
+    n->LHS->accept(this);
+    RelationEstimate in = estimate;
+    double s = estimateSelectivity(n->RHS.get(), in);
+
+    estimate = in;
+    estimate.rows *= s;
+    clampDistinct(estimate);
+}
+
+// visit project expression
+void CardinalityEstimator::visit(const Node::ProjectExpression* n) {
+    n->LHS->accept(this);
+    n->RHS->accept(this);
+}
+
+// visit column list
+void CardinalityEstimator::visit(const Node::ColumnList* n) {
+    RelationEstimate output;
+    output.rows = estimate.rows;
+    for (const auto& column : n->columns) {
+        int index = estimate.columnIndex(column->name);
+        output.columns.push_back(column->name);
+        output.distinct.push_back(index == -1 ? estimate.rows : estimate.distinct[index]);
+        output.statistics.push_back(index == -1 ? nullptr : estimate.statistics[index]);
+    }
+    estimate = std::move(output);
+}
+
+// visit union expression
+void CardinalityEstimator::visit(const Node::UnionExpression* n) {
+    n->LHS->accept(this);
+    RelationEstimate left = estimate;
+    n->RHS->accept(this);
+    RelationEstimate right = estimate;
+
+    // upper bound
+    estimate = left;
+    estimate.rows = left.rows + right.rows;
+    for (size_t c = 0; c < estimate.distinct.size() && c < right.distinct.size(); ++c) {
+        estimate.distinct[c] += right.distinct[c];
+    }
+    clampDistinct(estimate);
+}
+
+// visit difference expression
+void CardinalityEstimator::visit(const Node::DifferenceExpression* n) {
+    n->LHS->accept(this);
+    RelationEstimate left = estimate;
+    n->RHS->accept(this);
+
+    // upper bound
+    estimate = left;
+}
+
+// visit intersect expression
+void CardinalityEstimator::visit(const Node::IntersectExpression* n) {
+    n->LHS->accept(this);
+    RelationEstimate left = estimate;
+    n->RHS->accept(this);
+    RelationEstimate right = estimate;
+
+    // upper bound
+    estimate = left;
+    estimate.rows = std::min(left.rows, right.rows);
+    clampDistinct(estimate);
+}
+
+// visit join expression
+void CardinalityEstimator::visit(const Node::JoinExpression* n) {
+    n->LHS->accept(this);
+    RelationEstimate left = estimate;
+    n->RHS->accept(this);
+    RelationEstimate right = estimate;
+
+    estimate = estimateJoin(left, right);
+}
@@ -0,0 +1,459 @@
+// Catalog.cpp
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include "microRDB/Catalog.hpp"
+
+namespace {
+    void unknownTable(const std::string& name) {
+        std::cout << "Execution error. Unknown table \"" << name << "\". Terminating.\n";
+        exit(1);
+    }
+}
+
+const std::string& Catalog::resolve(const std::string& name) const {
+    const std::string* resolved = &name;
+    for (auto found = deferred.find(name); found != deferred.end(); found = deferred.find(*resolved)) {
+        const DeltaNode& plan = found->second->plan();
+        if (plan.kind != DeltaNode::scan) {
+            break;
+        }
+        resolved = &plan.tableName;
+    }
+    return *resolved;
+}
+
+Catalog::~Catalog() {
+    // a version only this snapshot still holds is freed on the collector's thread instead
+    for (auto& version : versions) {
+        if (version.second.use_count() == 1) {
+            collector->retire(std::move(version.second));
+        }
+    }
+}
+
+bool Catalog::contains(const std::string& name) const {
+    return tables.find(name) != tables.end();
+}
+
+const Table& Catalog::table(const std::string& name) const {
+    const std::string& resolved = resolve(name);
+    auto found = tables.find(resolved);
+    if (found == tables.end()) {
+        unknownTable(name);
+    }
+
+    // a snapshot's table not written yet is its version's rows
+    if (!found->second) {
+        return *versions.at(resolved)->materialize();
+    }
+    return *found->second;
+}
+
+const TableStatistics& Catalog::tableStatistics(const std::string& name) const {
+    auto found = statistics.find(resolve(name));
+    if (found == statistics.end()) {
+        unknownTable(name);
+    }
+    return *found->second;
+}
+
+TableStatistics& Catalog::writable(std::shared_ptr<TableStatistics>& version) {
+    // a snapshot dropped on another thread released its reads with the count, acquire them before writing
+    bool shared = version.use_count() > 1;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (shared) {
+        auto copy = std::make_shared<TableStatistics>(*version);
+        collector->retire(std::move(version));
+        version = std::move(copy);
+    }
+    return *version;
+}
+
+Table& Catalog::writableTable(const std::string& name) {
+    Table& table = appendableTable(name);
+    if (tracksWrites) {
+        writes.find(resolve(name))->second.rewritten = true;
+    }
+    return table;
+}
+
+TableStatistics& Catalog::writableStatistics(const std::string& name) {
+    auto found = statistics.find(resolve(name));
+    if (found == statistics.end()) {
+        unknownTable(name);
+    }
+    return writable(found->second);
+}
+
+Table& Catalog::appendableTable(const std::string& name) {
+    const std::string& resolved = resolve(name);
+    auto found = tables.find(resolved);
+    if (found == tables.end()) {
+        unknownTable(name);
+    }
+
+    // a snapshot writes a copy of its version's rows
+    if (!found->second) {
+        found->second = std::make_shared<Table>(*versions.at(resolved)->materialize());
+    }
+    if (tracksWrites) {
+        writes.find(resolved)->second.changed = true;
+    }
+    return *found->second;
+}
+
+void Catalog::noteErased(const std::string& name, const std::vector<uint32_t>& rows) {
+    if (tracksWrites) {
+        auto& erased = writes.find(resolve(name))->second.erased;
+        erased.insert(erased.end(), rows.begin(), rows.end());
+    }
+}
+
+void Catalog::noteUpdated(const std::string& name, const std::vector<uint32_t>& rows) {
+    if (tracksWrites) {
+        auto& updated = writes.find(resolve(name))->second.updated;
+        updated.insert(updated.end(), rows.begin(), rows.end());
+    }
+}
+
+void Catalog::create(const std::string& name, Table table) {
+    if (contains(name)) {
+        std::cout << "Execution error. Table \"" << name << "\" already exists. Terminating.\n";
+        exit(1);
+    }
+
+    tables.emplace(name, std::make_shared<Table>(std::move(table)));
+    statistics.emplace(name, std::make_shared<TableStatistics>());
+    writes.emplace(name, Writes{0, true, true, {}, {}});
+    analyze(name);
+    touch(name);
+    ++version;
+}
+
+void Catalog::drop(const std::string& name) {
+    if (!contains(name)) {
+        unknownTable(name);
+    }
+
+    tables.erase(name);
+    statistics.erase(name);
+    writes.erase(name);
+    if (compacting == name) {
+        compacting.clear();
+    }
+    dataVersions.erase(name);
+    deferred.erase(name);
+    lsmTrees.erase(name);
+    views.erase(std::remove_if(views.begin(), views.end(), [&](const auto& view) { return view.first == name; }),
+                views.end());
+    ++version;
+}
+
+void Catalog::analyze(const std::string& name) {
+    writableStatistics(name).analyze(table(name));
+}
+
+uint64_t Catalog::dataVersion(const std::string& name) const {
+    auto found = dataVersions.find(resolve(name));
+    return found == dataVersions.end() ? 0 : found->second;
+}
+
+void Catalog::touch(const std::string& name) {
+    uint64_t next = nextDataVersion++;
+    auto found = dataVersions.find(name);
+    if (found == dataVersions.end()) {
+        dataVersions.emplace(name, next);
+    }
+    else {
+        found->second = next;
+    }
+}
+
+void Catalog::maintain(const std::string& name, std::unique_ptr<IncrementalView> view) {
+    views.push_back({name, std::move(view)});
+}
+
+bool Catalog::isMaintained(const std::string& name) const {
+    for (const auto& view : views) {
+        if (view.first == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+IncrementalView& Catalog::maintainedView(const std::string& name) {
+    for (auto& view : views) {
+        if (view.first == name) {
+            return *view.second;
+        }
+    }
+    unknownTable(name);
+    return *views.front().second;
+}
+
+std::vector<std::string> Catalog::maintainedReaders(const std::string& name) const {
+    std::vector<std::string> readers;
+    for (const auto& view : views) {
+        const auto& sources = view.second->sourceTables();
+        if (std::find(sources.begin(), sources.end(), name) != sources.end()) {
+            readers.push_back(view.first);
+        }
+    }
+    return readers;
+}
+
+void Catalog::defer(const std::string& name, std::unique_ptr<IncrementalView> definition) {
+    deferred[name] = std::move(definition);
+}
+
+std::shared_ptr<const Table> Catalog::TableVersion::materialize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (rows) {
+        return rows;
+    }
+
+    // an LSM table's rows are read from the view without any lock on the tree
+    if (tree) {
+        auto table = std::make_shared<Table>();
+        table->columns = base->columns;
+        table->rows = tree->rows(view);
+        std::atomic_store(&rows, std::shared_ptr<const Table>(std::move(table)));
+        return rows;
+    }
+    if (!changes) {
+        std::atomic_store(&rows, base);
+        return rows;
+    }
+
+    // oldest changes first, each publish's updates are to rows before its appended ones
+    std::vector<const RowChanges*> chain;
+    for (const RowChanges* c = changes.get(); c != nullptr; c = c->previous.get()) {
+        chain.push_back(c);
+    }
+    auto table = std::make_shared<Table>(*base);
+    for (auto c = chain.rbegin(); c != chain.rend(); ++c) {
+        for (const auto& [r, row] : (*c)->updated) {
+            table->rows[r] = row;
+        }
+        table->rows.insert(table->rows.end(), (*c)->appended.begin(), (*c)->appended.end());
+        for (auto r : (*c)->erased) {
+            table->deleted.insert(r);
+        }
+    }
+    std::atomic_store(&rows, std::shared_ptr<const Table>(std::move(table)));
+    return rows;
+}
+
+std::shared_ptr<const Catalog::State> Catalog::nextState(const State* previous) {
+    if (!collector) {
+        collector = std::make_shared<VersionCollector>();
+    }
+    auto state = std::make_shared<State>();
+    state->statistics = statistics;
+    state->version = version;
+    state->dataVersions = dataVersions;
+    state->nextDataVersion = nextDataVersion.load();
+    state->deferred = deferred;
+
+    for (const auto& [name, table] : tables) {
+        auto version = std::make_shared<TableVersion>();
+        auto lsm = lsmTrees.find(name);
+        const Writes& written = writes.at(name);
+        std::shared_ptr<const TableVersion> last;
+        if (previous != nullptr && previous->tables.count(name) != 0) {
+            last = previous->tables.at(name);
+        }
+
+        if (lsm != lsmTrees.end()) {
+            auto columns = std::make_shared<Table>();
+            columns->columns = table->columns;
+            version->base = std::move(columns);
+            version->tree = lsm->second;
+            version->view = lsm->second->view();
+        }
+        else if (last && !written.changed) {
+            state->tables.emplace(name, std::move(last));
+            continue;
+        }
+        else if (last && !written.rewritten) {
+            // the last version's rows if a snapshot made them, so snapshots apply fewer changes
+            auto rows = std::atomic_load(&last->rows);
+            version->base = rows ? rows : last->base;
+            version->changes = rows ? nullptr : last->changes;
+            version->numChanged = rows ? 0 : last->numChanged;
+
+            auto changes = std::make_shared<RowChanges>();
+            changes->appended.assign(table->rows.begin() + written.numRows, table->rows.end());
+            changes->erased = written.erased;
+            for (auto r : written.updated) {
+                // appended rows were copied as they are now
+                if (r < written.numRows) {
+                    changes->updated.push_back({r, table->rows[r]});
+                }
+            }
+            changes->previous = version->changes;
+            version->numChanged += 1 + changes->appended.size() + changes->erased.size() + changes->updated.size();
+            version->changes = std::move(changes);
+        }
+
+        // a new table, one whose rows were rewritten, or one whose changes outgrew the copy they are on
+        if (!version->tree && (!version->base || version->numChanged > rebaseFraction * version->base->rows.size())) {
+            version->base = std::make_shared<Table>(*table);
+            version->changes = nullptr;
+            version->numChanged = 0;
+        }
+        state->tables.emplace(name, std::move(version));
+    }
+    return state;
+}
+
+std::unique_ptr<Catalog> Catalog::snapshot() {
+    std::shared_ptr<const State> state;
+    {
+        std::lock_guard<std::mutex> lock(publishedMutex);
+        state = published;
+    }
+    if (!state) {
+        auto lock = lockStatement();
+        state = nextState(nullptr);
+    }
+
+    // rows are only made from the versions of the tables a statement reads
+    auto copy = std::make_unique<Catalog>();
+    copy->collector = collector;
+    for (const auto& [name, version] : state->tables) {
+        copy->tables.emplace(name, nullptr);
+    }
+    copy->versions = state->tables;
+    copy->statistics = state->statistics;
+    copy->version = state->version;
+    copy->dataVersions = state->dataVersions;
+    copy->nextDataVersion = state->nextDataVersion;
+    copy->deferred = state->deferred;
+    return copy;
+}
+
+void Catalog::openSnapshotReader() {
+    auto lock = lockStatement();
+    ++numSnapshotReaders;
+    publish();
+}
+
+void Catalog::closeSnapshotReader() {
+    // the published state is let go where the next statement ends
+    --numSnapshotReaders;
+}
+
+void Catalog::publish() {
+    // the published state is only replaced under the statement lock, which the caller holds
+    if (numSnapshotReaders == 0 && !published) {
+        return;
+    }
+    std::shared_ptr<const State> state = numSnapshotReaders > 0 ? nextState(published.get()) : nullptr;
+
+    // writes are noted from here on, relative to the rows the tables have now
+    bool tracked = tracksWrites;
+    tracksWrites = state != nullptr;
+    for (auto& [name, written] : writes) {
+        if (!tracked || written.changed) {
+            written = Writes{tables.at(name)->rows.size(), false, false, {}, {}};
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(publishedMutex);
+        published.swap(state);
+    }
+    if (state) {
+        collector->retire(std::move(state));
+    }
+}
+
+bool Catalog::isDeferred(const std::string& name) const {
+    return deferred.find(name) != deferred.end();
+}
+
+const IncrementalView& Catalog::deferredDefinition(const std::string& name) const {
+    auto found = deferred.find(name);
+    if (found == deferred.end()) {
+        unknownTable(name);
+    }
+    return *found->second;
+}
+
+std::vector<std::string> Catalog::deferredReaders(const std::string& name) const {
+    std::vector<std::string> readers;
+    for (const auto& definition : deferred) {
+        if (definition.second->sourceTables().front() == name) {
+            readers.push_back(definition.first);
+        }
+    }
+    return readers;
+}
+
+void Catalog::materialize(const std::string& name, std::vector<Row> rows) {
+    deferred.erase(name);
+    Table& table = writableTable(name);
+    table.rows = std::move(rows);
+    table.deleted = DeletionBitmap();
+    analyze(name);
+    touch(name);
+}
+
+void Catalog::storeInLsm(const std::string& name, std::shared_ptr<LsmTree> tree) {
+    lsmTrees[name] = std::move(tree);
+}
+
+bool Catalog::isLsm(const std::string& name) const {
+    return lsmTrees.find(name) != lsmTrees.end();
+}
+
+LsmTree& Catalog::lsmTree(const std::string& name) {
+    auto found = lsmTrees.find(name);
+    if (found == lsmTrees.end()) {
+        unknownTable(name);
+    }
+    return *found->second;
+}
+
+void Catalog::compactLater() {
+    std::call_once(compactorCreated, [this] { compactor = std::make_unique<Compactor>([this] { return compactSlice(); }); });
+    compactor->notify();
+}
+
+bool Catalog::compactSlice() {
+    auto lock = lockStatement();
+
+    // the changes a publish keeps are row positions, rows stay where they are while writes are noted
+    if (tracksWrites) {
+        compacting.clear();
+        return false;
+    }
+
+    // the first segment over the threshold of some table, the rows before it stay as they are
+    for (auto table = tables.begin(); table != tables.end() && compacting.empty(); ++table) {
+        const DeletionBitmap& deleted = table->second->deleted;
+        size_t numRows = table->second->rows.size();
+        for (size_t begin = 0; begin < numRows && !deleted.empty(); begin += DeletionBitmap::segmentSize) {
+            size_t segmentRows = std::min(DeletionBitmap::segmentSize, numRows - begin);
+            if (deleted.countIn(begin / DeletionBitmap::segmentSize) >= compactionThreshold * segmentRows) {
+                compacting = table->first;
+                compactingFrom = begin;
+                break;
+            }
+        }
+    }
+    if (compacting.empty()) {
+        return false;
+    }
+
+    auto& version = tables.find(compacting)->second;
+    compactingFrom = version->compact(compactingFrom, compactionSliceRows);
+    if (compactingFrom == version->rows.size()) {
+        compacting.clear();
+    }
+    return true;
+}
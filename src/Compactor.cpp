@@ -0,0 +1,45 @@
+// Compactor.cpp
+
+#include <utility>
+#include "microRDB/Compactor.hpp"
+
+Compactor::Compactor(std::function<bool()> slice)
+    : slice(std::move(slice)), thread(&Compactor::compactLoop, this) {}
+
+Compactor::~Compactor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    thread.join();
+}
+
+void Compactor::notify() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = true;
+    }
+    wake.notify_all();
+}
+
+void Compactor::compactLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return pending || stopping; });
+        if (stopping) {
+            return;
+        }
+        pending = false;
+
+        lock.unlock();
+        bool more = slice();
+        lock.lock();
+
+        // rate limited, the next slice waits out the interval
+        if (more) {
+            wake.wait_for(lock, interval, [this] { return stopping; });
+            pending = true;
+        }
+    }
+}
@@ -41,7 +41,7 @@ void DOTVisitor::visit(const Node::Create* n) {
 
     // create this node
     dotFile << "node" << std::to_string(thisId)
-            << " [label=\"create\\n" + n->tableName + "\"];\n";
+            << " [label=\"create" << (n->maintained ? " maintained" : "") << "\\n" + n->tableName + "\"];\n";
 
     // process child(ren)
     int exprId = nodeId;
@@ -93,6 +93,16 @@ void DOTVisitor::visit(const Node::Drop* n) {
             << " [label=\"drop\\n" + n->tableName + "\"];\n";
 }
 
+// visit analyze
+void DOTVisitor::visit(const Node::Analyze* n) {
+    size_t thisId = nodeId;
+    ++nodeId;
+
+    // create this node
+    dotFile << "node" << std::to_string(thisId)
+            << " [label=\"analyze\n" + n->tableName + "\"];\n";
+}
+
 // visit delete
 void DOTVisitor::visit(const Node::Delete* n) {
     size_t thisId = nodeId;
@@ -222,6 +232,61 @@ void DOTVisitor::visit(const Node::Insert* n) {
     }
 }
 
+// visit bulk insert
+// drawn like the insert it replaces, one expression list of literals per row
+void DOTVisitor::visit(const Node::BulkInsert* n) {
+    size_t thisId = nodeId;
+    ++nodeId;
+
+    // create this node
+    dotFile << "node" << std::to_string(thisId)
+            << " [label=\"insert\\n" + n->tableName + "\"];\n";
+
+    // process child(ren)
+    std::vector<int> exprListIds = {};
+    for (size_t r = 0; r < n->numRows; ++r) {
+        size_t listId = nodeId;
+        ++nodeId;
+        exprListIds.push_back(listId);
+        dotFile << "node" << std::to_string(listId)
+                << " [label=\"expression list\"];\n";
+
+        std::vector<int> exprIds = {};
+        const Node::Literal* literals = n->row(r);
+        for (size_t c = 0; c < n->numColumns; ++c) {
+            exprIds.push_back(nodeId);
+            dotFile << "node" << std::to_string(nodeId) << " [label=\"";
+            switch (literals[c].type) {
+                case Node::Literal::intType: dotFile << "int literal\\n" << std::to_string(literals[c].intValue); break;
+                case Node::Literal::floatType: dotFile << "float literal\\n" << std::to_string(literals[c].floatValue); break;
+                case Node::Literal::boolType: dotFile << "bool literal\\n" << (literals[c].boolValue ? "true" : "false"); break;
+                case Node::Literal::charsType: dotFile << "chars literal\\n" << literals[c].charsValue; break;
+            }
+            dotFile << "\"];\n";
+            ++nodeId;
+        }
+
+        for (auto id : exprIds) {
+            dotFile << "node" << std::to_string(listId) << " -- node" << std::to_string(id) << ";\n";
+        }
+    }
+
+    // connect child(ren) to this node
+    for (auto id : exprListIds) {
+        dotFile << "node" << std::to_string(thisId) << " -- node" << std::to_string(id) << ";\n";
+    }
+}
+
+// visit load
+void DOTVisitor::visit(const Node::Load* n) {
+    size_t thisId = nodeId;
+    ++nodeId;
+
+    // create this node
+    dotFile << "node" << std::to_string(thisId)
+            << " [label=\"load\\n" + n->tableName + "\\n" << n->path << "\"];\n";
+}
+
 // visit expression list
 void DOTVisitor::visit(const Node::ExpressionList* n) {
     size_t thisId = nodeId;
@@ -291,7 +356,7 @@ void DOTVisitor::visit(const Node::EqualityExpression* n) {
 
     // create this node
     dotFile << "node" << std::to_string(thisId)
-            << " [label=\"" + n->op + "\"];\n";
+            << " [label=\"" << Node::operatorString(n->op) << "\"];\n";
 
     // process children
     int leftId = nodeId;
@@ -311,7 +376,7 @@ void DOTVisitor::visit(const Node::RelationalExpression* n) {
 
     // create this node
     dotFile << "node" << std::to_string(thisId)
-            << " [label=\"" + n->op + "\"];\n";
+            << " [label=\"" << Node::operatorString(n->op) << "\"];\n";
 
     // process children
     int leftId = nodeId;
@@ -331,7 +396,7 @@ void DOTVisitor::visit(const Node::AdditiveExpression* n) {
 
     // create this node
     dotFile << "node" << std::to_string(thisId)
-            << " [label=\"" + n->op + "\"];\n";
+            << " [label=\"" << Node::operatorString(n->op) << "\"];\n";
 
     // process children
     int leftId = nodeId;
@@ -351,7 +416,7 @@ void DOTVisitor::visit(const Node::MultiplicativeExpression* n) {
 
     // create this node
     dotFile << "node" << std::to_string(thisId)
-            << " [label=\"" + n->op + "\"];\n";
+            << " [label=\"" << Node::operatorString(n->op) << "\"];\n";
 
     // process children
     int leftId = nodeId;
@@ -411,7 +476,17 @@ void DOTVisitor::visit(const Node::CharsLiteral* n) {
 
     // create this node
     dotFile << "node" << std::to_string(thisId)
-            << " [label=\"chars literal\\n" + n->value + "\"];\n";
+            << " [label=\"chars literal\\n" << n->value << "\"];\n";
+}
+
+// visit parameter
+void DOTVisitor::visit(const Node::Parameter* n) {
+    size_t thisId = nodeId;
+    ++nodeId;
+
+    // create this node
+    dotFile << "node" << std::to_string(thisId)
+            << " [label=\"parameter\\n$" + std::to_string(n->index) + "\"];\n";
 }
 
 // visit select expression
@@ -0,0 +1,77 @@
+// DeletionBitmap.cpp
+
+#include <algorithm>
+#include "microRDB/DeletionBitmap.hpp"
+
+void DeletionBitmap::insert(size_t row) {
+    size_t w = row / 64;
+    if (w >= words.size()) {
+        words.resize(w + 1, 0);
+        segmentCounts.resize(row / segmentSize + 1, 0);
+    }
+    uint64_t bit = uint64_t(1) << (row % 64);
+    if ((words[w] & bit) == 0) {
+        words[w] |= bit;
+        ++segmentCounts[row / segmentSize];
+        ++total;
+    }
+}
+
+void DeletionBitmap::erase(size_t row) {
+    if (!contains(row)) {
+        return;
+    }
+    words[row / 64] &= ~(uint64_t(1) << (row % 64));
+    --segmentCounts[row / segmentSize];
+    --total;
+}
+
+size_t DeletionBitmap::skipDeleted(size_t row) const {
+    while (row / 64 < words.size()) {
+        // a fully deleted segment is skipped whole
+        size_t segment = row / segmentSize;
+        if (row % segmentSize == 0 && segmentCounts[segment] == segmentSize) {
+            row += segmentSize;
+            continue;
+        }
+
+        uint64_t live = ~words[row / 64] >> (row % 64);
+        if (live != 0) {
+            return row + __builtin_ctzll(live);
+        }
+        row = (row / 64 + 1) * 64;
+    }
+    return row;
+}
+
+size_t DeletionBitmap::nextDeleted(size_t row, size_t end) const {
+    size_t limit = std::min(end, words.size() * 64);
+    while (row < limit) {
+        // a segment without deleted rows is skipped whole
+        size_t segment = row / segmentSize;
+        if (segmentCounts[segment] == 0) {
+            row = (segment + 1) * segmentSize;
+            continue;
+        }
+
+        uint64_t deleted = words[row / 64] >> (row % 64);
+        if (deleted != 0) {
+            return std::min(end, row + __builtin_ctzll(deleted));
+        }
+        row = (row / 64 + 1) * 64;
+    }
+    return end;
+}
+
+void DeletionBitmap::truncate(size_t numRows) {
+    for (size_t row = nextDeleted(numRows, words.size() * 64); row < words.size() * 64; row = nextDeleted(row + 1, words.size() * 64)) {
+        erase(row);
+    }
+    if (total == 0) {
+        words.clear();
+        segmentCounts.clear();
+        return;
+    }
+    words.resize(std::min(words.size(), (numRows + 63) / 64));
+    segmentCounts.resize(std::min(segmentCounts.size(), (numRows + segmentSize - 1) / segmentSize));
+}
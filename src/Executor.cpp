@@ -0,0 +1,1652 @@
+// Executor.cpp
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+#include "microRDB/Node.hpp"
+#include "microRDB/BatchEvaluator.hpp"
+#include "microRDB/Binder.hpp"
+#include "microRDB/BulkLoader.hpp"
+#include "microRDB/Executor.hpp"
+#include "microRDB/CardinalityEstimator.hpp"
+#include "microRDB/GenericJoin.hpp"
+#include "microRDB/Lexer.hpp"
+#include "microRDB/Parser.hpp"
+#include "microRDB/QueryHasher.hpp"
+#include "microRDB/StatementWriter.hpp"
+
+namespace {
+    void executionError(const std::string& message) {
+        std::cout << "Execution error. " << message << " Terminating.\n";
+        exit(1);
+    }
+
+    // an executor running inside another's statement or script neither replays nor writes the log,
+    // caches results nor schedules statements of its own
+    ExecutionOptions evaluatorOptions(ExecutionOptions options) {
+        options.walPath.clear();
+        options.resultCacheSize = 0;
+        options.parallelStatements = false;
+        return options;
+    }
+
+    // leaves of a ^ chain, parenthesized sub-chains included
+    void collectJoinLeaves(const Node::Node* n, std::vector<const Node::Node*>& leaves) {
+        const auto* join = dynamic_cast<const Node::JoinExpression*>(n);
+        if (join == nullptr) {
+            leaves.push_back(n);
+            return;
+        }
+        collectJoinLeaves(join->LHS.get(), leaves);
+        collectJoinLeaves(join->RHS.get(), leaves);
+    }
+
+    // relational expressions that compute something, a bare table name is cheaper to scan than to cache
+    bool isCacheableQuery(const Node::Node* n) {
+        return dynamic_cast<const Node::SelectExpression*>(n) != nullptr
+               || dynamic_cast<const Node::ProjectExpression*>(n) != nullptr
+               || dynamic_cast<const Node::UnionExpression*>(n) != nullptr
+               || dynamic_cast<const Node::DifferenceExpression*>(n) != nullptr
+               || dynamic_cast<const Node::IntersectExpression*>(n) != nullptr
+               || dynamic_cast<const Node::JoinExpression*>(n) != nullptr;
+    }
+
+    // base tables a relational expression reads
+    void collectTables(const Node::Node* n, std::vector<std::string>& tables) {
+        if (const auto* identifier = dynamic_cast<const Node::Identifier*>(n)) {
+            tables.push_back(identifier->name);
+        }
+        else if (const auto* select = dynamic_cast<const Node::SelectExpression*>(n)) {
+            collectTables(select->LHS.get(), tables);
+        }
+        else if (const auto* project = dynamic_cast<const Node::ProjectExpression*>(n)) {
+            collectTables(project->LHS.get(), tables);
+        }
+        else if (const auto* unite = dynamic_cast<const Node::UnionExpression*>(n)) {
+            collectTables(unite->LHS.get(), tables);
+            collectTables(unite->RHS.get(), tables);
+        }
+        else if (const auto* difference = dynamic_cast<const Node::DifferenceExpression*>(n)) {
+            collectTables(difference->LHS.get(), tables);
+            collectTables(difference->RHS.get(), tables);
+        }
+        else if (const auto* intersect = dynamic_cast<const Node::IntersectExpression*>(n)) {
+            collectTables(intersect->LHS.get(), tables);
+            collectTables(intersect->RHS.get(), tables);
+        }
+        else if (const auto* join = dynamic_cast<const Node::JoinExpression*>(n)) {
+            collectTables(join->LHS.get(), tables);
+            collectTables(join->RHS.get(), tables);
+        }
+    }
+
+    // a chain of selects and projects over one table
+    bool isDeferrable(const Node::Node* n) {
+        if (const auto* select = dynamic_cast<const Node::SelectExpression*>(n)) {
+            return isDeferrable(select->LHS.get());
+        }
+        if (const auto* project = dynamic_cast<const Node::ProjectExpression*>(n)) {
+            return isDeferrable(project->LHS.get());
+        }
+        return dynamic_cast<const Node::Identifier*>(n) != nullptr;
+    }
+
+    // table a statement changes or drops, null for creates and queries
+    const std::string* changedTable(const Node::Node* n) {
+        if (const auto* insert = dynamic_cast<const Node::Insert*>(n)) return &insert->tableName;
+        if (const auto* bulkInsert = dynamic_cast<const Node::BulkInsert*>(n)) return &bulkInsert->tableName;
+        if (const auto* load = dynamic_cast<const Node::Load*>(n)) return &load->tableName;
+        if (const auto* deleteStatement = dynamic_cast<const Node::Delete*>(n)) return &deleteStatement->tableName;
+        if (const auto* update = dynamic_cast<const Node::Update*>(n)) return &update->tableName;
+        if (const auto* drop = dynamic_cast<const Node::Drop*>(n)) return &drop->tableName;
+        if (const auto* analyze = dynamic_cast<const Node::Analyze*>(n)) return &analyze->tableName;
+        return nullptr;
+    }
+
+    // statements the redo log replays, statistics are rebuilt from the rows so analyze is left out
+    // unlogged loads are left out too, they trade recovery for load speed
+    bool isLogged(const Node::Node* n, const ExecutionOptions& options) {
+        if (options.unloggedLoads && dynamic_cast<const Node::Load*>(n) != nullptr) {
+            return false;
+        }
+        return dynamic_cast<const Node::Create*>(n) != nullptr
+               || (changedTable(n) != nullptr && dynamic_cast<const Node::Analyze*>(n) == nullptr);
+    }
+
+    // rows per insert record of a load
+    constexpr size_t loadRecordRows = 4096;
+
+    // statements that only add rows to a table
+    bool isAppend(const Node::Node* n) {
+        return dynamic_cast<const Node::Insert*>(n) != nullptr || dynamic_cast<const Node::BulkInsert*>(n) != nullptr
+               || dynamic_cast<const Node::Load*>(n) != nullptr;
+    }
+
+    // a literal or parameter a point lookup can search for
+    bool lookupConstant(const Node::Node* n, const std::vector<Value>* parameters, Value& constant) {
+        if (const auto* literal = dynamic_cast<const Node::IntLiteral*>(n)) {
+            constant = Value(literal->value);
+        }
+        else if (const auto* literal = dynamic_cast<const Node::FloatLiteral*>(n)) {
+            constant = Value(literal->value);
+        }
+        else if (const auto* literal = dynamic_cast<const Node::BoolLiteral*>(n)) {
+            constant = Value(literal->value);
+        }
+        else if (const auto* literal = dynamic_cast<const Node::CharsLiteral*>(n)) {
+            constant = Value(std::string(literal->value));
+        }
+        else if (const auto* parameter = dynamic_cast<const Node::Parameter*>(n)) {
+            constant = (*parameters)[parameter->index - 1];
+        }
+        else {
+            return false;
+        }
+        return true;
+    }
+
+    // the key of a point lookup on a table, when the select right over its scan first tests its first column for equality
+    // a row that fails that test is never looked at again, so rows without the key need not be read at all
+    bool pointLookupKey(const Node::Node* n, const std::string& tableName, Value::Type keyType,
+                        const std::vector<Value>* parameters, Value& key) {
+        if (const auto* select = dynamic_cast<const Node::SelectExpression*>(n)) {
+            const auto* identifier = dynamic_cast<const Node::Identifier*>(select->LHS.get());
+            if (identifier == nullptr || identifier->name != tableName) {
+                return pointLookupKey(select->LHS.get(), tableName, keyType, parameters, key);
+            }
+
+            // the test && evaluates first
+            const Node::Node* first = select->RHS.get();
+            while (const auto* conjunction = dynamic_cast<const Node::AndExpression*>(first)) {
+                first = conjunction->LHS.get();
+            }
+            const auto* equality = dynamic_cast<const Node::EqualityExpression*>(first);
+            if (equality == nullptr || equality->op != Node::opEquals) {
+                return false;
+            }
+            for (const auto& [column, constant] : {std::make_pair(equality->LHS.get(), equality->RHS.get()),
+                                                   std::make_pair(equality->RHS.get(), equality->LHS.get())}) {
+                const auto* reference = dynamic_cast<const Node::Identifier*>(column);
+                if (reference != nullptr && reference->ordinal == 0 && lookupConstant(constant, parameters, key)
+                    && key.type == keyType) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        if (const auto* project = dynamic_cast<const Node::ProjectExpression*>(n)) {
+            return pointLookupKey(project->LHS.get(), tableName, keyType, parameters, key);
+        }
+        const Node::Node* LHS = nullptr;
+        const Node::Node* RHS = nullptr;
+        if (const auto* unite = dynamic_cast<const Node::UnionExpression*>(n)) {
+            LHS = unite->LHS.get();
+            RHS = unite->RHS.get();
+        }
+        else if (const auto* difference = dynamic_cast<const Node::DifferenceExpression*>(n)) {
+            LHS = difference->LHS.get();
+            RHS = difference->RHS.get();
+        }
+        else if (const auto* intersect = dynamic_cast<const Node::IntersectExpression*>(n)) {
+            LHS = intersect->LHS.get();
+            RHS = intersect->RHS.get();
+        }
+        else if (const auto* join = dynamic_cast<const Node::JoinExpression*>(n)) {
+            LHS = join->LHS.get();
+            RHS = join->RHS.get();
+        }
+        return LHS != nullptr
+               && (pointLookupKey(LHS, tableName, keyType, parameters, key) || pointLookupKey(RHS, tableName, keyType, parameters, key));
+    }
+
+    // tables a statement reads and tables it changes, a changed table counts as read
+    void accessedTables(const Node::Node* n, std::vector<std::string>& reads, std::vector<std::string>& writes) {
+        if (const std::string* changed = changedTable(n)) {
+            reads.push_back(*changed);
+            writes.push_back(*changed);
+            return;
+        }
+        collectTables(n, reads);
+    }
+
+    // the live rows of [begin, end) of a table as a batch's selection
+    void selectBatch(const DeletionBitmap& deleted, size_t begin, size_t end, std::vector<uint32_t>& selection) {
+        selection.clear();
+        for (size_t r = deleted.nextLive(begin); r < end; r = deleted.nextLive(r + 1)) {
+            selection.push_back(static_cast<uint32_t>(r));
+        }
+    }
+
+    // assigned values in their column's type, checked like coerce checks them one value at a time
+    void coerceBatch(BatchEvaluator::Vector& values, const Column& column) {
+        if (values.type == column.type) {
+            if (values.type == Value::charsType) {
+                for (const auto& v : values.chars) {
+                    if (v.size() > column.numChars) {
+                        executionError("Value \"" + std::string(v) + "\" is longer than chars " + std::to_string(column.numChars)
+                                       + " column \"" + column.name + "\".");
+                    }
+                }
+            }
+            return;
+        }
+        if (column.type == Value::floatType && values.type == Value::intType) {
+            values.floats.assign(values.ints.begin(), values.ints.end());
+            values.ints.clear();
+            values.type = Value::floatType;
+            return;
+        }
+
+        executionError("Cannot store " + Value::typeName(values.type) + " in " + Value::typeName(column.type)
+                       + " column \"" + column.name + "\".");
+    }
+
+    // change that adds rows
+    ZSet insertion(const std::vector<Row>& rows) {
+        ZSet change;
+        for (const auto& inserted : rows) {
+            accumulate(change, inserted, 1);
+        }
+        return change;
+    }
+
+    bool containsAll(const std::vector<std::string>& columns, const std::vector<std::string>& names) {
+        for (const auto& name : names) {
+            if (std::find(columns.begin(), columns.end(), name) == columns.end()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // hash of a row's key columns, independent of the rest of the row
+    uint64_t hashKey(const Row& row, const std::vector<size_t>& keys) {
+        uint64_t seed = keys.size();
+        for (auto k : keys) {
+            seed ^= row[k].hash() + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+
+    Value literalValue(const Node::Literal& literal) {
+        switch (literal.type) {
+            case Node::Literal::intType: return Value(literal.intValue);
+            case Node::Literal::floatType: return Value(literal.floatValue);
+            case Node::Literal::boolType: return Value(literal.boolValue);
+            case Node::Literal::charsType: return Value(std::string(literal.charsValue));
+        }
+        return Value();
+    }
+
+    // numeric operand as a double, the binder has resolved whether it holds an int or a float
+    double numeric(const Value& v, Value::Type type) {
+        return type == Value::intType ? v.intValue : v.floatValue;
+    }
+
+    // three-way comparison of operands of the bound types, ints are promoted when compared with floats
+    int compare(const Value& lhs, Value::Type lhsType, const Value& rhs, Value::Type rhsType) {
+        if (lhsType != rhsType || lhsType == Value::floatType) {
+            double l = numeric(lhs, lhsType);
+            double r = numeric(rhs, rhsType);
+            return (l > r) - (l < r);
+        }
+        if (lhsType == Value::intType) {
+            return (lhs.intValue > rhs.intValue) - (lhs.intValue < rhs.intValue);
+        }
+        if (lhsType == Value::boolType) {
+            return lhs.boolValue - rhs.boolValue;
+        }
+        int c = lhs.charsValue.compare(rhs.charsValue);
+        return (c > 0) - (c < 0);
+    }
+
+    // +, -, *, /, % of operands of the bound types, ints are promoted when combined with floats
+    Value arithmetic(const Value& lhs, Value::Type lhsType, const Value& rhs, Value::Type rhsType, Node::Operator op) {
+        if (lhsType == Value::intType && rhsType == Value::intType) {
+            long long l = lhs.intValue;
+            long long r = rhs.intValue;
+            if ((op == Node::opDivide || op == Node::opModulus) && r == 0) {
+                executionError("Integer division by zero.");
+            }
+            if (op == Node::opPlus) return Value(static_cast<int>(l + r));
+            if (op == Node::opMinus) return Value(static_cast<int>(l - r));
+            if (op == Node::opMultiply) return Value(static_cast<int>(l * r));
+            if (op == Node::opDivide) return Value(static_cast<int>(l / r));
+            return Value(static_cast<int>(l % r));
+        }
+
+        float l = numeric(lhs, lhsType);
+        float r = numeric(rhs, rhsType);
+        if (op == Node::opPlus) return Value(l + r);
+        if (op == Node::opMinus) return Value(l - r);
+        if (op == Node::opMultiply) return Value(l * r);
+        if (op == Node::opDivide) return Value(l / r);
+        return Value(std::fmod(l, r));
+    }
+}
+
+void Executor::compilePipeline(const Node::Node* n, Pipeline& pipeline) {
+    // selections and projections fuse onto whatever pipeline their input ends in
+    if (const auto* select = dynamic_cast<const Node::SelectExpression*>(n)) {
+        compilePipeline(select->LHS.get(), pipeline);
+        pipeline.addFilter(select->RHS.get());
+        return;
+    }
+    if (const auto* project = dynamic_cast<const Node::ProjectExpression*>(n)) {
+        compilePipeline(project->LHS.get(), pipeline);
+        std::vector<std::string> columnNames;
+        for (const auto& column : dynamic_cast<const Node::ColumnList*>(project->RHS.get())->columns) {
+            columnNames.push_back(column->name);
+        }
+        pipeline.addProject(columnNames);
+        return;
+    }
+
+    // base tables are scanned in place
+    if (const auto* identifier = dynamic_cast<const Node::Identifier*>(n)) {
+        pipeline.scan(&catalog.table(identifier->name), identifier->name);
+        return;
+    }
+
+    if (const auto* join = dynamic_cast<const Node::JoinExpression*>(n)) {
+        compileJoinChain(join, pipeline);
+        return;
+    }
+
+    // set operations are pipeline breakers
+    n->accept(this);
+    pipeline.scan(std::move(relation), "(materialized)");
+}
+
+void Executor::compileJoinChain(const Node::JoinExpression* n, Pipeline& pipeline) {
+    // natural join is associative and commutative up to column order, so the whole ^ chain is reordered
+    std::vector<const Node::Node*> leafNodes;
+    collectJoinLeaves(n, leafNodes);
+
+    CardinalityEstimator estimator(catalog);
+    JoinChain chain;
+    std::vector<RelationEstimate> estimates;
+    for (const auto* leafNode : leafNodes) {
+        RelationEstimate estimate = estimator.estimateRelation(leafNode);
+
+        // base tables are estimated from statistics and scanned later
+        const auto* identifier = dynamic_cast<const Node::Identifier*>(leafNode);
+        if (identifier != nullptr) {
+            const Table& table = catalog.table(identifier->name);
+            Table columnsOnly;
+            columnsOnly.columns = table.columns;
+            chain.leaves.push_back(std::move(columnsOnly));
+            chain.baseTables.push_back(&table);
+            chain.names.push_back(identifier->name);
+            estimates.push_back(std::move(estimate));
+            continue;
+        }
+
+        // other inputs are evaluated now, row counts come from the result
+        leafNode->accept(this);
+        estimate.rows = relation.rows.size();
+        for (auto& d : estimate.distinct) {
+            d = std::min(d, estimate.rows);
+        }
+        chain.leaves.push_back(std::move(relation));
+        chain.baseTables.push_back(nullptr);
+        chain.names.push_back("(subquery " + std::to_string(chain.names.size() + 1) + ")");
+        estimates.push_back(std::move(estimate));
+    }
+
+    // output columns in the order the textual left-deep chain would produce them
+    std::vector<std::string> columnOrder;
+    for (const auto& leaf : chain.leaves) {
+        for (const auto& column : leaf.columns) {
+            if (std::find(columnOrder.begin(), columnOrder.end(), column.name) == columnOrder.end()) {
+                columnOrder.push_back(column.name);
+            }
+        }
+    }
+
+    // cyclic chains use a worst-case optimal multi-way join instead of binary hash joins
+    if (chain.leaves.size() >= 3 && JoinOrderer::isCyclic(estimates)) {
+        if (options.explain) {
+            std::cout << "join plan: generic join over";
+            for (const auto& name : chain.names) {
+                std::cout << " " << name;
+            }
+            std::cout << " (cyclic)\n";
+        }
+
+        std::vector<const Table*> inputs;
+        for (size_t i = 0; i < chain.leaves.size(); ++i) {
+            inputs.push_back(chain.baseTables[i] != nullptr ? chain.baseTables[i] : &chain.leaves[i]);
+        }
+        pipeline.scan(GenericJoin(inputs, columnOrder).execute(), "(generic join)");
+        return;
+    }
+
+    JoinOrderer orderer;
+    auto plan = orderer.order(estimates);
+    if (options.explain) {
+        std::cout << "join plan: " << plan->toString(chain.names)
+                  << " (estimated " << std::llround(plan->estimate.rows) << " rows, build sides first)\n";
+    }
+
+    compileJoinPlan(plan.get(), chain, {}, pipeline);
+
+    bool reordered = pipeline.schema.columns.size() != columnOrder.size();
+    for (size_t i = 0; i < columnOrder.size() && !reordered; ++i) {
+        reordered = pipeline.schema.columns[i].name != columnOrder[i];
+    }
+    if (reordered) {
+        pipeline.addProject(columnOrder);
+    }
+}
+
+void Executor::compileJoinPlan(const JoinPlan* plan, JoinChain& chain, const std::vector<RuntimeFilter*>& filters, Pipeline& pipeline) {
+    if (plan->leaf != -1) {
+        if (chain.baseTables[plan->leaf] != nullptr) {
+            pipeline.scan(chain.baseTables[plan->leaf], chain.names[plan->leaf]);
+        }
+        else {
+            pipeline.scan(std::move(chain.leaves[plan->leaf]), chain.names[plan->leaf]);
+        }
+
+        // runtime filters run first, rejected rows never reach the rest of the pipeline
+        for (auto* filter : filters) {
+            pipeline.addRuntimeFilter(filter);
+        }
+        return;
+    }
+
+    // route incoming filters to the side that has all of their key columns
+    std::vector<RuntimeFilter*> buildFilters;
+    std::vector<RuntimeFilter*> probeFilters;
+    std::vector<RuntimeFilter*> residualFilters;
+    for (auto* filter : filters) {
+        if (containsAll(plan->probe->estimate.columns, filter->keys)) {
+            probeFilters.push_back(filter);
+        }
+        else if (containsAll(plan->build->estimate.columns, filter->keys)) {
+            buildFilters.push_back(filter);
+        }
+        else {
+            residualFilters.push_back(filter);
+        }
+    }
+
+    // hash build is a pipeline breaker, the build side runs as its own pipeline
+    Pipeline buildPipeline;
+    compileJoinPlan(plan->build.get(), chain, buildFilters, buildPipeline);
+    Table build = runPipeline(buildPipeline);
+
+    // semi-join reduction: probe rows whose keys cannot be in the build side never leave the scan
+    std::vector<size_t> buildKeys;
+    std::vector<std::string> keys;
+    for (size_t b = 0; b < build.columns.size(); ++b) {
+        if (plan->probe->estimate.columnIndex(build.columns[b].name) != -1) {
+            keys.push_back(build.columns[b].name);
+            buildKeys.push_back(b);
+        }
+    }
+    if (!keys.empty()) {
+        auto filter = std::make_unique<RuntimeFilter>(build.rows.size());
+        filter->keys = keys;
+        for (const auto& current : build.rows) {
+            filter->bloom.add(hashKey(current, buildKeys));
+        }
+        probeFilters.push_back(filter.get());
+        pipeline.filters.push_back(std::move(filter));
+        pipeline.filterDescriptions.push_back(plan->build->toString(chain.names) + " -> " + plan->probe->toString(chain.names));
+    }
+
+    // the probe side continues this pipeline
+    compileJoinPlan(plan->probe.get(), chain, probeFilters, pipeline);
+    pipeline.addProbe(std::move(build));
+    for (auto* filter : residualFilters) {
+        pipeline.addRuntimeFilter(filter);
+    }
+}
+
+// per-morsel state of a running pipeline
+struct Executor::MorselState {
+    Executor evaluator;
+    std::vector<Row>& output;
+    std::vector<size_t> tested;
+    std::vector<size_t> passed;
+    std::vector<Row> keys;
+
+    MorselState(Catalog& catalog, const ExecutionOptions& options, std::vector<Row>& output, size_t numSteps)
+        : evaluator(catalog, evaluatorOptions(options)), output(output), tested(numSteps, 0), passed(numSteps, 0), keys(numSteps) {}
+};
+
+Table Executor::runPipeline(Pipeline& pipeline) {
+    if (options.explain) {
+        std::cout << "pipeline: " << pipeline.toString() << "\n";
+    }
+
+    const Table& source = *pipeline.source;
+    size_t numSteps = pipeline.steps.size();
+    size_t numMorsels = morselCount(source.rows.size());
+    std::vector<std::vector<Row>> outputs(numMorsels);
+    std::vector<std::vector<size_t>> tested(numMorsels);
+    std::vector<std::vector<size_t>> passed(numMorsels);
+    threadPool().parallelFor(source.rows.size(), options.morselSize, [&](size_t m, size_t begin, size_t end) {
+        MorselState state(catalog, options, outputs[m], numSteps);
+        state.evaluator.parameters = parameters;
+        for (size_t i = source.deleted.nextLive(begin); i < end; i = source.deleted.nextLive(i + 1)) {
+            push(pipeline, 0, source.rows[i], state);
+        }
+        tested[m] = std::move(state.tested);
+        passed[m] = std::move(state.passed);
+    });
+
+    for (size_t s = 0; s < numSteps; ++s) {
+        if (pipeline.steps[s].kind != PipelineStep::runtimeFilterStep) {
+            continue;
+        }
+        for (size_t m = 0; m < numMorsels; ++m) {
+            pipeline.steps[s].filter->tested += tested[m][s];
+            pipeline.steps[s].filter->passed += passed[m][s];
+        }
+    }
+
+    if (options.stats) {
+        for (size_t f = 0; f < pipeline.filters.size(); ++f) {
+            const RuntimeFilter& filter = *pipeline.filters[f];
+            double rate = filter.tested == 0 ? 100.0 : 100.0 * filter.passed / filter.tested;
+            std::cout << "stats: runtime filter " << pipeline.filterDescriptions[f]
+                      << " passed " << filter.passed << " of " << filter.tested << " rows (" << rate << "%)\n";
+        }
+    }
+
+    Table output;
+    output.columns = pipeline.schema.columns;
+    for (auto& rows : outputs) {
+        std::move(rows.begin(), rows.end(), std::back_inserter(output.rows));
+    }
+    return output;
+}
+
+void Executor::push(const Pipeline& pipeline, size_t s, const Row& current, MorselState& state) {
+    for (; s < pipeline.steps.size(); ++s) {
+        const PipelineStep& step = pipeline.steps[s];
+        switch (step.kind) {
+            case PipelineStep::filterStep:
+                state.evaluator.rowTable = &step.schema;
+                state.evaluator.row = &current;
+                if (!state.evaluator.evaluateCondition(step.predicate)) {
+                    return;
+                }
+                break;
+
+            case PipelineStep::runtimeFilterStep:
+                ++state.tested[s];
+                if (!step.filter->bloom.mayContain(hashKey(current, step.indices))) {
+                    return;
+                }
+                ++state.passed[s];
+                break;
+
+            case PipelineStep::projectStep: {
+                Row projected;
+                projected.reserve(step.indices.size());
+                for (auto index : step.indices) {
+                    projected.push_back(current[index]);
+                }
+                push(pipeline, s + 1, projected, state);
+                return;
+            }
+
+            case PipelineStep::probeStep: {
+                Row& key = state.keys[s];
+                key.resize(step.indices.size());
+                for (size_t k = 0; k < step.indices.size(); ++k) {
+                    key[k] = current[step.indices[k]];
+                }
+
+                auto matches = step.hashTable->buckets.find(key);
+                if (matches == step.hashTable->buckets.end()) {
+                    return;
+                }
+                const Table& build = step.hashTable->build;
+                for (auto i : matches->second) {
+                    Row joined = current;
+                    for (size_t b = 0; b < build.columns.size(); ++b) {
+                        if (!step.hashTable->buildIsKey[b]) {
+                            joined.push_back(build.rows[i][b]);
+                        }
+                    }
+                    push(pipeline, s + 1, joined, state);
+                }
+                return;
+            }
+        }
+    }
+
+    // sink
+    state.output.push_back(current);
+}
+
+ThreadPool& Executor::threadPool() {
+    if (scriptPool != nullptr) {
+        return *scriptPool;
+    }
+    if (!pool) {
+        pool = std::make_unique<ThreadPool>(options.threads);
+    }
+    return *pool;
+}
+
+size_t Executor::morselCount(size_t rows) const {
+    size_t morselSize = std::max<size_t>(options.morselSize, 1);
+    return (rows + morselSize - 1) / morselSize;
+}
+
+Value Executor::evaluate(const Node::Node* expr) {
+    bool wasEvaluatingScalar = evaluatingScalar;
+    evaluatingScalar = true;
+    expr->accept(this);
+    evaluatingScalar = wasEvaluatingScalar;
+    return value;
+}
+
+bool Executor::evaluateCondition(const Node::Node* expr) {
+    // the binder has checked that conditions are bools
+    return evaluate(expr).boolValue;
+}
+
+Value Executor::coerce(const Value& v, const Column& column) {
+    if (v.type == column.type) {
+        if (v.type == Value::charsType && v.charsValue.size() > column.numChars) {
+            executionError("Value \"" + v.charsValue + "\" is longer than chars " + std::to_string(column.numChars)
+                           + " column \"" + column.name + "\".");
+        }
+        return v;
+    }
+    if (column.type == Value::floatType && v.type == Value::intType) {
+        return Value(static_cast<float>(v.intValue));
+    }
+
+    executionError("Cannot store " + Value::typeName(v.type) + " in " + Value::typeName(column.type)
+                   + " column \"" + column.name + "\".");
+    return v;
+}
+
+Executor::Executor(Catalog& catalog, const ExecutionOptions& options)
+    : catalog(catalog), options(options) {
+    if (!options.walPath.empty()) {
+        recover();
+        log = std::make_unique<WriteAheadLog>(options.walPath);
+        recordsLoads = !options.unloggedLoads;
+    }
+}
+
+void Executor::recover() {
+    std::string committed = WriteAheadLog::recover(options.walPath);
+    auto tokens = Lexer().lexViews(committed);
+    if (tokens.empty()) {
+        return;
+    }
+
+    // the log holds no bare select expressions, so replaying prints nothing
+    bool explain = options.explain;
+    bool stats = options.stats;
+    options.explain = false;
+    options.stats = false;
+    Parser(tokens).parse()->accept(this);
+    options.explain = explain;
+    options.stats = stats;
+}
+
+bool Executor::beginTransaction() {
+    if (!options.scriptTransactions || transactionLock.owns_lock()) {
+        return false;
+    }
+    transactionLock = catalog.lockStatement();
+    return true;
+}
+
+void Executor::commit() {
+    if (log) {
+        size_t records = log->commit();
+        if (options.stats && records > 0) {
+            std::cout << "stats: log flush " << log->flushes() << ", " << records << " statements\n";
+        }
+    }
+    if (transactionLock.owns_lock()) {
+        catalog.publish();
+        transactionLock.unlock();
+    }
+}
+
+bool Executor::isQuery(const Node::Node* statement) {
+    return isCacheableQuery(statement) || dynamic_cast<const Node::Identifier*>(statement) != nullptr;
+}
+
+void Executor::execute(const Node::Node* statement, const std::vector<Value>* parameterValues) {
+    // snapshots see the state published where a statement, or a transaction, ends
+    // a statement run beside others of its script holds the script's lock and leaves printing, logging and publishing to it
+    bool beside = scriptPool != nullptr;
+    std::unique_lock<std::mutex> statementLock;
+    if (!transactionLock.owns_lock() && !beside) {
+        statementLock = catalog.lockStatement();
+    }
+    parameters = parameterValues;
+    producedRelation = false;
+    materializeDeferred(statement);
+    std::vector<std::string> loaded = loadLsmTables(statement);
+    if (options.resultCacheSize > 0 && isCacheableQuery(statement)) {
+        executeCached(statement);
+    }
+    else {
+        statement->accept(this);
+    }
+    storeLsmTables(statement, loaded);
+    if (beside) {
+        parameters = nullptr;
+        return;
+    }
+
+    // redo record, flushed on its own unless a transaction flushes it with the rest
+    logStatement(statement);
+    if (!transactionLock.owns_lock()) {
+        if (log) {
+            commit();
+        }
+        catalog.publish();
+    }
+    parameters = nullptr;
+    printRelation();
+}
+
+void Executor::logStatement(const Node::Node* statement) {
+    if (!log || !isLogged(statement, options)) {
+        return;
+    }
+    if (dynamic_cast<const Node::Load*>(statement) != nullptr) {
+        for (const auto& record : loadRecords) {
+            log->append(record);
+        }
+        loadRecords.clear();
+        return;
+    }
+    log->append(StatementWriter(parameters).write(statement));
+}
+
+void Executor::printRelation() {
+    // bare select expressions print their result
+    if (producedRelation) {
+        relation.print();
+    }
+}
+
+void Executor::executeCached(const Node::Node* query) {
+    if (!resultCache) {
+        resultCache = std::make_unique<ResultCache>(options.resultCacheSize);
+    }
+
+    // the hash picks the entry, the written text confirms it is the same query
+    QueryHasher hasher(parameters);
+    uint64_t key = hasher.hashQuery(query);
+    std::string text = StatementWriter(parameters).write(query);
+    const Table* cached = resultCache->find(key, text, catalog);
+    if (options.stats) {
+        std::cout << "stats: result cache " << (cached != nullptr ? "hit" : "miss") << ", " << resultCache->hits()
+                  << " of " << resultCache->lookups() << " lookups hit (" << 100.0 * resultCache->hitRatio() << "%)\n";
+    }
+
+    if (cached != nullptr) {
+        relation = *cached;
+        producedRelation = true;
+        return;
+    }
+
+    query->accept(this);
+    resultCache->insert(key, text, hasher.tablesRead(), catalog, relation);
+}
+
+IncrementalView::Condition Executor::viewCondition() {
+    return [this](const Node::Node* predicate, const Row& current) {
+        const Row* outerRow = row;
+        row = &current;
+        bool matches = evaluateCondition(predicate);
+        row = outerRow;
+        return matches;
+    };
+}
+
+void Executor::maintainViews(const std::string& tableName, const ZSet& change) {
+    if (change.empty()) {
+        return;
+    }
+
+    for (const auto& name : catalog.maintainedReaders(tableName)) {
+        ZSet delta = catalog.maintainedView(name).propagate(tableName, change, viewCondition());
+        if (delta.empty()) {
+            continue;
+        }
+        for (const auto& reader : catalog.deferredReaders(name)) {
+            materialize(reader);
+        }
+
+        // removed rows are taken out in one pass, added rows go at the end
+        ZSet removed;
+        for (const auto& [current, weight] : delta) {
+            if (weight < 0) {
+                removed.emplace(current, -weight);
+            }
+        }
+        Table& table = removed.empty() ? catalog.appendableTable(name) : catalog.writableTable(name);
+        TableStatistics& statistics = catalog.writableStatistics(name);
+        if (!removed.empty()) {
+            // rows a delete left in place go with them
+            std::vector<Row> kept;
+            kept.reserve(table.rows.size());
+            for (size_t r = table.deleted.nextLive(0); r < table.rows.size(); r = table.deleted.nextLive(r + 1)) {
+                Row& current = table.rows[r];
+                auto found = removed.find(current);
+                if (found != removed.end() && found->second > 0) {
+                    --found->second;
+                    statistics.onDelete(current);
+                }
+                else {
+                    kept.push_back(std::move(current));
+                }
+            }
+            table.rows = std::move(kept);
+            table.deleted = DeletionBitmap();
+        }
+        for (const auto& [current, weight] : delta) {
+            for (long copies = 0; copies < weight; ++copies) {
+                statistics.onInsert(current);
+                table.rows.push_back(current);
+            }
+        }
+        if (statistics.needsAnalyze()) {
+            catalog.analyze(name);
+        }
+        catalog.touch(name);
+
+        // maintained tables over this one
+        maintainViews(name, delta);
+    }
+}
+
+void Executor::materializeDeferred(const Node::Node* statement) {
+    if (const std::string* changed = changedTable(statement)) {
+        // deferred tables over it keep the rows it has now
+        for (const auto& reader : catalog.deferredReaders(*changed)) {
+            materialize(reader);
+        }
+        if (catalog.isDeferred(*changed) && dynamic_cast<const Node::Drop*>(statement) == nullptr) {
+            materialize(*changed);
+        }
+        return;
+    }
+
+    // plain copies keep reading their source's rows
+    std::vector<std::string> tables;
+    const auto* create = dynamic_cast<const Node::Create*>(statement);
+    collectTables(create != nullptr ? create->expression.get() : statement, tables);
+    for (const auto& table : tables) {
+        if (catalog.isDeferred(table) && catalog.deferredDefinition(table).plan().kind != DeltaNode::scan) {
+            materialize(table);
+        }
+    }
+}
+
+void Executor::materialize(const std::string& tableName) {
+    catalog.materialize(tableName, evaluateDeferred(catalog.deferredDefinition(tableName).plan()));
+}
+
+std::vector<Row> Executor::evaluateDeferred(const DeltaNode& plan) {
+    if (plan.kind == DeltaNode::scan) {
+        return catalog.table(plan.tableName).live().rows;
+    }
+
+    // a scanned table is read in place instead of copied first, skipping its deleted rows
+    std::vector<Row> evaluated;
+    const std::vector<Row>* input = &evaluated;
+    DeletionBitmap none;
+    const DeletionBitmap* deleted = &none;
+    if (plan.inputs[0]->kind == DeltaNode::scan) {
+        const Table& scanned = catalog.table(plan.inputs[0]->tableName);
+        input = &scanned.rows;
+        deleted = &scanned.deleted;
+    }
+    else {
+        evaluated = evaluateDeferred(*plan.inputs[0]);
+    }
+
+    // in input order, like the pipeline the create would have run
+    std::vector<Row> rows;
+    if (plan.kind == DeltaNode::select) {
+        IncrementalView::Condition condition = viewCondition();
+        for (size_t r = deleted->nextLive(0); r < input->size(); r = deleted->nextLive(r + 1)) {
+            if (condition(plan.predicate, (*input)[r])) {
+                rows.push_back((*input)[r]);
+            }
+        }
+    }
+    else {
+        rows.reserve(input->size() - deleted->count());
+        for (size_t r = deleted->nextLive(0); r < input->size(); r = deleted->nextLive(r + 1)) {
+            Row projected;
+            projected.reserve(plan.ordinals.size());
+            for (auto ordinal : plan.ordinals) {
+                projected.push_back((*input)[r][ordinal]);
+            }
+            rows.push_back(std::move(projected));
+        }
+    }
+    return rows;
+}
+
+std::vector<std::string> Executor::loadLsmTables(const Node::Node* statement) {
+    // appends and drops do not read the table they change
+    std::vector<std::string> tables;
+    const auto* create = dynamic_cast<const Node::Create*>(statement);
+    collectTables(create != nullptr ? create->expression.get() : statement, tables);
+    const std::string* changed = changedTable(statement);
+    if (changed != nullptr && !isAppend(statement) && dynamic_cast<const Node::Drop*>(statement) == nullptr) {
+        tables.push_back(*changed);
+    }
+
+    std::vector<std::string> loaded;
+    for (const auto& name : tables) {
+        if (!catalog.isLsm(name) || std::find(loaded.begin(), loaded.end(), name) != loaded.end()) {
+            continue;
+        }
+
+        // a query scanning the table once, through a key equality, reads only the rows with that key
+        Table& table = catalog.writableTable(name);
+        LsmTree& tree = catalog.lsmTree(name);
+        Value key;
+        bool point = create == nullptr && changed == nullptr && std::count(tables.begin(), tables.end(), name) == 1
+                     && pointLookupKey(statement, name, table.columns[0].type, parameters, key);
+        if (point) {
+            table.rows = tree.lookup(key);
+        }
+        else {
+            table.rows = tree.rows(changed != nullptr && *changed == name ? &lsmRowIds : nullptr);
+        }
+        loaded.push_back(name);
+    }
+    return loaded;
+}
+
+void Executor::storeLsmTables(const Node::Node* statement, const std::vector<std::string>& loaded) {
+    const std::string* changed = changedTable(statement);
+    if (changed != nullptr && isAppend(statement) && catalog.isLsm(*changed)) {
+        Table& table = catalog.writableTable(*changed);
+        catalog.lsmTree(*changed).append(std::move(table.rows));
+        table.rows = std::vector<Row>();
+    }
+
+    // deletes and updates write tombstones and new versions of just the rows they changed
+    for (const auto& name : loaded) {
+        Table& table = catalog.writableTable(name);
+        if (changed != nullptr && *changed == name) {
+            LsmTree& tree = catalog.lsmTree(name);
+            std::vector<LsmTree::RowId> erased;
+            for (size_t r = table.deleted.nextDeleted(0, table.rows.size()); r < table.rows.size();
+                 r = table.deleted.nextDeleted(r + 1, table.rows.size())) {
+                erased.push_back(lsmRowIds[r]);
+            }
+            tree.erase(erased);
+
+            std::vector<LsmTree::RowId> replaced;
+            std::vector<Row> updated;
+            for (uint32_t r : lsmUpdatedRows) {
+                replaced.push_back(lsmRowIds[r]);
+                updated.push_back(std::move(table.rows[r]));
+            }
+            tree.update(replaced, std::move(updated));
+        }
+        table.rows = std::vector<Row>();
+        table.deleted = DeletionBitmap();
+    }
+    lsmRowIds.clear();
+    lsmUpdatedRows.clear();
+
+    if (options.stats && changed != nullptr && catalog.isLsm(*changed)) {
+        LsmTree& tree = catalog.lsmTree(*changed);
+        std::cout << "stats: lsm " << *changed << " " << tree.size() << " rows, " << tree.numRuns() << " runs\n";
+    }
+}
+
+// visit script
+void Executor::visit(const Node::Script* n) {
+    bool transaction = beginTransaction();
+
+    // --explain and --stats print while operators run, so their statements stay serial
+    bool concurrent = options.parallelStatements && !options.explain && !options.stats;
+    std::vector<const Node::Node*> run;
+    for (const auto& statement : n->statements) {
+        // a run creates and drops no tables, so its statements are bound as they join it,
+        // one that fails to bind lets the run ahead of it finish before terminating
+        if (concurrent && isConcurrent(statement.get())) {
+            Binder binder(catalog);
+            binder.beforeError = [&] { executeConcurrently(run); };
+            statement->accept(&binder);
+            run.push_back(statement.get());
+            continue;
+        }
+        executeConcurrently(run);
+        run.clear();
+
+        // bound right before it runs, so it sees the tables the statements before it created
+        Binder binder(catalog);
+        statement->accept(&binder);
+        execute(statement.get());
+    }
+    executeConcurrently(run);
+
+    if (transaction) {
+        commit();
+    }
+}
+
+bool Executor::isConcurrent(const Node::Node* statement) const {
+    // creates and drops change the set of tables the others look theirs up in, analyze prints as it runs
+    if (dynamic_cast<const Node::Create*>(statement) != nullptr || dynamic_cast<const Node::Drop*>(statement) != nullptr
+        || dynamic_cast<const Node::Analyze*>(statement) != nullptr) {
+        return false;
+    }
+
+    // views and deferred tables change, or are computed, along with the tables they read
+    // LSM tables are filled in and handed back to their trees around a statement, by execute
+    std::vector<std::string> reads;
+    std::vector<std::string> writes;
+    accessedTables(statement, reads, writes);
+    for (const auto& name : reads) {
+        if (catalog.isDeferred(name) || catalog.isMaintained(name) || !catalog.deferredReaders(name).empty()
+            || !catalog.maintainedReaders(name).empty() || catalog.isLsm(name)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Executor::executeConcurrently(const std::vector<const Node::Node*>& statements) {
+    if (statements.size() <= 1) {
+        for (const auto* statement : statements) {
+            execute(statement);
+        }
+        return;
+    }
+
+    // a statement runs one level after the latest earlier statement it conflicts with,
+    // a write conflicts with any read or write of the same table
+    std::unordered_map<std::string, size_t> readAfter; // first level after the last write of a table
+    std::unordered_map<std::string, size_t> writeAfter; // first level after its last read or write
+    std::vector<std::vector<size_t>> levels;
+    for (size_t i = 0; i < statements.size(); ++i) {
+        std::vector<std::string> reads;
+        std::vector<std::string> writes;
+        accessedTables(statements[i], reads, writes);
+        size_t level = 0;
+        for (const auto& name : reads) {
+            level = std::max(level, readAfter[name]);
+        }
+        for (const auto& name : writes) {
+            level = std::max(level, writeAfter[name]);
+        }
+        for (const auto& name : reads) {
+            writeAfter[name] = std::max(writeAfter[name], level + 1);
+        }
+        for (const auto& name : writes) {
+            readAfter[name] = level + 1;
+        }
+        if (level == levels.size()) {
+            levels.emplace_back();
+        }
+        levels[level].push_back(i);
+    }
+
+    std::unique_lock<std::mutex> statementLock;
+    if (!transactionLock.owns_lock()) {
+        statementLock = catalog.lockStatement();
+    }
+
+    // every statement gets its own executor, they share the script's pool for their own parallel operators
+    ThreadPool& scriptThreads = threadPool();
+    std::vector<std::unique_ptr<Executor>> executors(statements.size());
+    for (const auto& level : levels) {
+        scriptThreads.parallelFor(level.size(), 1, [&](size_t m, size_t, size_t) {
+            size_t i = level[m];
+            executors[i] = std::make_unique<Executor>(catalog, evaluatorOptions(options));
+            executors[i]->scriptPool = &scriptThreads;
+            executors[i]->recordsLoads = recordsLoads;
+            executors[i]->execute(statements[i]);
+        });
+    }
+
+    // printed and logged in script order
+    for (size_t i = 0; i < statements.size(); ++i) {
+        executors[i]->printRelation();
+        loadRecords = std::move(executors[i]->loadRecords);
+        logStatement(statements[i]);
+    }
+    if (!transactionLock.owns_lock()) {
+        if (log) {
+            commit();
+        }
+        catalog.publish();
+    }
+}
+
+// visit create
+void Executor::visit(const Node::Create* n) {
+    // computed when a statement first reads it, a plain copy shares its source's rows until then
+    // not over an LSM table, whose rows are only there while a statement reads them
+    std::vector<std::string> sources;
+    collectTables(n->expression.get(), sources);
+    bool readsLsm = std::any_of(sources.begin(), sources.end(), [&](const auto& name) { return catalog.isLsm(name); });
+    if (!n->maintained && options.deferCreates && isDeferrable(n->expression.get()) && !readsLsm) {
+        auto definition = std::make_unique<IncrementalView>(n->expression.get(), catalog, parameters);
+        Table deferred;
+        deferred.columns = definition->plan().columns;
+        catalog.create(n->tableName, std::move(deferred));
+        catalog.defer(n->tableName, std::move(definition));
+        producedRelation = false;
+        return;
+    }
+
+    relation = Table();
+    n->expression->accept(this);
+
+    // planned before the table exists, so the view cannot read itself
+    std::unique_ptr<IncrementalView> view;
+    if (n->maintained) {
+        view = std::make_unique<IncrementalView>(n->expression.get(), catalog, parameters);
+        view->initialize(catalog, viewCondition());
+    }
+
+    // with an LSM directory, tables declared from a name-type list keep their rows in an LSM tree
+    bool declared = dynamic_cast<const Node::NameTypeList*>(n->expression.get()) != nullptr;
+    std::vector<Column> columns = relation.columns;
+    catalog.create(n->tableName, std::move(relation));
+    if (view) {
+        catalog.maintain(n->tableName, std::move(view));
+    }
+    if (declared && !options.lsmPath.empty()) {
+        catalog.storeInLsm(n->tableName, std::make_shared<LsmTree>(options.lsmPath, n->tableName, columns));
+    }
+    relation = Table();
+    producedRelation = false;
+}
+
+// visit name-type list
+void Executor::visit(const Node::NameTypeList* n) {
+    relation = Table();
+    for (const auto& pair : n->nameTypePairs) {
+        pair->accept(this);
+    }
+}
+
+// visit name-type pair
+void Executor::visit(const Node::NameTypePair* n) {
+    if (relation.columnIndex(n->name) != -1) {
+        executionError("Duplicate column name \"" + n->name + "\".");
+    }
+
+    if (n->type == "int") {
+        relation.columns.push_back(Column(n->name, Value::intType));
+    }
+    else if (n->type == "float") {
+        relation.columns.push_back(Column(n->name, Value::floatType));
+    }
+    else if (n->type == "bool") {
+        relation.columns.push_back(Column(n->name, Value::boolType));
+    }
+    else {
+        relation.columns.push_back(Column(n->name, Value::charsType, std::stoi(n->numChars)));
+    }
+}
+
+// visit drop
+void Executor::visit(const Node::Drop* n) {
+    catalog.drop(n->tableName);
+}
+
+// visit analyze
+void Executor::visit(const Node::Analyze* n) {
+    catalog.analyze(n->tableName);
+    std::cout << n->tableName << ": ";
+    catalog.tableStatistics(n->tableName).print(catalog.table(n->tableName));
+}
+
+// visit delete
+void Executor::visit(const Node::Delete* n) {
+    Table& table = catalog.appendableTable(n->tableName);
+    TableStatistics& statistics = catalog.writableStatistics(n->tableName);
+    bool maintained = !catalog.maintainedReaders(n->tableName).empty();
+    ZSet change;
+
+    // filters are implicitly anded, each narrows a batch's selection to the rows it holds for
+    // deleted rows stay in place until the compactor removes them, scans skip them until then
+    BatchEvaluator evaluator(table.rows, parameters);
+    std::vector<uint32_t> selection;
+    size_t numDeleted = table.deleted.count();
+    for (size_t begin = 0; begin < table.rows.size(); begin += BatchEvaluator::batchSize) {
+        selectBatch(table.deleted, begin, std::min(table.rows.size(), begin + BatchEvaluator::batchSize), selection);
+        for (const auto& filter : n->filters) {
+            evaluator.filter(filter->expr.get(), selection);
+        }
+        for (uint32_t r : selection) {
+            table.deleted.insert(r);
+            statistics.onDelete(table.rows[r]);
+            if (maintained) {
+                accumulate(change, table.rows[r], -1);
+            }
+        }
+        catalog.noteErased(n->tableName, selection);
+    }
+    if (table.deleted.count() != numDeleted) {
+        catalog.compactLater();
+    }
+
+    catalog.touch(n->tableName);
+    maintainViews(n->tableName, change);
+    if (statistics.needsAnalyze()) {
+        catalog.analyze(n->tableName);
+    }
+}
+
+// visit filter
+void Executor::visit(const Node::Filter* n) {
+    value = Value(evaluateCondition(n->expr.get()));
+}
+
+// visit update
+void Executor::visit(const Node::Update* n) {
+    Table& table = catalog.appendableTable(n->tableName);
+    TableStatistics& statistics = catalog.writableStatistics(n->tableName);
+    bool maintained = !catalog.maintainedReaders(n->tableName).empty();
+    ZSet change;
+
+    // every assignment is evaluated and checked, the last one to a column is the one written
+    std::vector<const Node::Assign*> assigns;
+    for (const auto& assign : dynamic_cast<const Node::AssignList*>(n->assignList.get())->assigns) {
+        assigns.push_back(dynamic_cast<const Node::Assign*>(assign.get()));
+    }
+    std::vector<bool> written(assigns.size(), true);
+    for (size_t a = 0; a < assigns.size(); ++a) {
+        for (size_t later = a + 1; later < assigns.size(); ++later) {
+            written[a] = written[a] && assigns[later]->ordinal != assigns[a]->ordinal;
+        }
+    }
+
+    BatchEvaluator evaluator(table.rows, parameters);
+    std::vector<uint32_t> selection;
+    std::vector<BatchEvaluator::Vector> assigned(assigns.size());
+    std::vector<std::vector<std::string>> chars(assigns.size());
+    std::vector<Row> oldRows;
+    bool lsm = catalog.isLsm(n->tableName);
+    for (size_t begin = 0; begin < table.rows.size(); begin += BatchEvaluator::batchSize) {
+        // filters are implicitly anded, each narrows a batch's selection to the rows it holds for
+        selectBatch(table.deleted, begin, std::min(table.rows.size(), begin + BatchEvaluator::batchSize), selection);
+        for (const auto& filter : n->filters) {
+            evaluator.filter(filter->expr.get(), selection);
+        }
+        if (selection.empty()) {
+            continue;
+        }
+
+        // every assignment sees the rows as they were before the update
+        for (size_t a = 0; a < assigns.size(); ++a) {
+            assigned[a] = evaluator.evaluate(assigns[a]->expr.get(), selection);
+            coerceBatch(assigned[a], table.columns[assigns[a]->ordinal]);
+        }
+        catalog.noteUpdated(n->tableName, selection);
+        if (lsm) {
+            lsmUpdatedRows.insert(lsmUpdatedRows.end(), selection.begin(), selection.end());
+        }
+        if (maintained) {
+            oldRows.clear();
+            for (uint32_t r : selection) {
+                oldRows.push_back(table.rows[r]);
+            }
+        }
+
+        // chars view the rows being written, so they are all copied out before any column is written
+        for (size_t a = 0; a < assigns.size(); ++a) {
+            if (written[a] && assigned[a].type == Value::charsType) {
+                chars[a].assign(assigned[a].chars.begin(), assigned[a].chars.end());
+            }
+        }
+
+        // one column at a time
+        statistics.onUpdateRows(selection.size());
+        for (size_t a = 0; a < assigns.size(); ++a) {
+            if (!written[a]) {
+                continue;
+            }
+            size_t ordinal = assigns[a]->ordinal;
+            bool isChars = assigned[a].type == Value::charsType;
+            for (size_t k = 0; k < selection.size(); ++k) {
+                Value& cell = table.rows[selection[k]][ordinal];
+                Value updated = isChars ? Value(std::move(chars[a][k])) : BatchEvaluator::valueAt(assigned[a], k);
+                statistics.onUpdateCell(ordinal, cell, updated);
+                cell = std::move(updated);
+            }
+        }
+
+        if (maintained) {
+            for (size_t k = 0; k < selection.size(); ++k) {
+                accumulate(change, oldRows[k], -1);
+                accumulate(change, table.rows[selection[k]], 1);
+            }
+        }
+    }
+    catalog.touch(n->tableName);
+    maintainViews(n->tableName, change);
+
+    if (statistics.needsAnalyze()) {
+        catalog.analyze(n->tableName);
+    }
+}
+
+// visit assign list
+void Executor::visit(const Node::AssignList* n) {}
+
+// visit assign
+void Executor::visit(const Node::Assign* n) {}
+
+// visit insert
+void Executor::visit(const Node::Insert* n) {
+    Table& table = catalog.appendableTable(n->tableName);
+    TableStatistics& statistics = catalog.writableStatistics(n->tableName);
+    bool maintained = !catalog.maintainedReaders(n->tableName).empty();
+    ZSet change;
+
+    for (const auto& expressionList : n->expressionLists) {
+        // the binder has checked the number of values and their types
+        expressionList->accept(this);
+        Row inserted;
+        inserted.reserve(values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            inserted.push_back(coerce(values[i], table.columns[i]));
+        }
+        statistics.onInsert(inserted);
+        if (maintained) {
+            accumulate(change, inserted, 1);
+        }
+        table.rows.push_back(std::move(inserted));
+    }
+    catalog.touch(n->tableName);
+    maintainViews(n->tableName, change);
+}
+
+// visit bulk insert
+void Executor::visit(const Node::BulkInsert* n) {
+    Table& table = catalog.appendableTable(n->tableName);
+    TableStatistics& statistics = catalog.writableStatistics(n->tableName);
+    if (n->numColumns != table.columns.size()) {
+        executionError("Table \"" + n->tableName + "\" has " + std::to_string(table.columns.size())
+                       + " columns, but " + std::to_string(n->numColumns) + " values were given.");
+    }
+
+    // validate every value against the schema before storing any, errors match coerce
+    for (size_t r = 0; r < n->numRows; ++r) {
+        const Node::Literal* literals = n->row(r);
+        for (size_t c = 0; c < n->numColumns; ++c) {
+            const Column& column = table.columns[c];
+            const Node::Literal& literal = literals[c];
+            bool fits = false;
+            switch (literal.type) {
+                case Node::Literal::intType: fits = column.type == Value::intType || column.type == Value::floatType; break;
+                case Node::Literal::floatType: fits = column.type == Value::floatType; break;
+                case Node::Literal::boolType: fits = column.type == Value::boolType; break;
+                case Node::Literal::charsType:
+                    fits = column.type == Value::charsType && literal.charsValue.size() <= column.numChars;
+                    break;
+            }
+            if (!fits) {
+                coerce(literalValue(literal), column);
+            }
+        }
+    }
+
+    // typed values straight from the literals, stored as one batch
+    std::vector<Row> batch(n->numRows);
+    for (size_t r = 0; r < n->numRows; ++r) {
+        const Node::Literal* literals = n->row(r);
+        Row& inserted = batch[r];
+        inserted.reserve(n->numColumns);
+        for (size_t c = 0; c < n->numColumns; ++c) {
+            if (table.columns[c].type == Value::floatType && literals[c].type == Node::Literal::intType) {
+                inserted.push_back(Value(static_cast<float>(literals[c].intValue)));
+            }
+            else {
+                inserted.push_back(literalValue(literals[c]));
+            }
+        }
+        statistics.onInsert(inserted);
+    }
+    ZSet change;
+    if (!catalog.maintainedReaders(n->tableName).empty()) {
+        change = insertion(batch);
+    }
+    table.rows.insert(table.rows.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+    catalog.touch(n->tableName);
+    maintainViews(n->tableName, change);
+}
+
+// visit load
+void Executor::visit(const Node::Load* n) {
+    Table& table = catalog.appendableTable(n->tableName);
+    TableStatistics& statistics = catalog.writableStatistics(n->tableName);
+
+    std::vector<Row> loaded = BulkLoader(threadPool()).load(std::string(n->path), table.columns);
+    loadRecords.clear();
+    if (recordsLoads) {
+        StatementWriter writer;
+        for (size_t begin = 0; begin < loaded.size(); begin += loadRecordRows) {
+            loadRecords.push_back(writer.writeInsert(n->tableName, loaded, begin, std::min(loaded.size(), begin + loadRecordRows)));
+        }
+    }
+    for (const auto& inserted : loaded) {
+        statistics.onInsert(inserted);
+    }
+    ZSet change;
+    if (!catalog.maintainedReaders(n->tableName).empty()) {
+        change = insertion(loaded);
+    }
+    table.rows.reserve(table.rows.size() + loaded.size());
+    table.rows.insert(table.rows.end(), std::make_move_iterator(loaded.begin()), std::make_move_iterator(loaded.end()));
+    catalog.touch(n->tableName);
+    maintainViews(n->tableName, change);
+}
+
+// visit expression list
+void Executor::visit(const Node::ExpressionList* n) {
+    values.clear();
+    for (const auto& expr : n->expressions) {
+        values.push_back(evaluate(expr.get()));
+    }
+}
+
+// visit or expression
+void Executor::visit(const Node::OrExpression* n) {
+    value = Value(evaluateCondition(n->LHS.get()) || evaluateCondition(n->RHS.get()));
+}
+
+// visit and expression
+void Executor::visit(const Node::AndExpression* n) {
+    value = Value(evaluateCondition(n->LHS.get()) && evaluateCondition(n->RHS.get()));
+}
+
+// visit equality expression
+void Executor::visit(const Node::EqualityExpression* n) {
+    Value lhs = evaluate(n->LHS.get());
+    Value rhs = evaluate(n->RHS.get());
+    int c = compare(lhs, n->LHS->binding.type, rhs, n->RHS->binding.type);
+    value = Value(n->op == Node::opEquals ? c == 0 : c != 0);
+}
+
+// visit relational expression
+void Executor::visit(const Node::RelationalExpression* n) {
+    Value lhs = evaluate(n->LHS.get());
+    Value rhs = evaluate(n->RHS.get());
+    int c = compare(lhs, n->LHS->binding.type, rhs, n->RHS->binding.type);
+    if (n->op == Node::opLessThan) value = Value(c < 0);
+    else if (n->op == Node::opGreaterThan) value = Value(c > 0);
+    else if (n->op == Node::opLessThanOrEquals) value = Value(c <= 0);
+    else value = Value(c >= 0);
+}
+
+// visit additive expression
+void Executor::visit(const Node::AdditiveExpression* n) {
+    Value lhs = evaluate(n->LHS.get());
+    Value rhs = evaluate(n->RHS.get());
+    value = arithmetic(lhs, n->LHS->binding.type, rhs, n->RHS->binding.type, n->op);
+}
+
+// visit multiplicative expression
+void Executor::visit(const Node::MultiplicativeExpression* n) {
+    Value lhs = evaluate(n->LHS.get());
+    Value rhs = evaluate(n->RHS.get());
+    value = arithmetic(lhs, n->LHS->binding.type, rhs, n->RHS->binding.type, n->op);
+}
+
+// visit identifier
+void Executor::visit(const Node::Identifier* n) {
+    // column reference, resolved by the binder
+    if (evaluatingScalar) {
+        value = (*row)[n->ordinal];
+        return;
+    }
+
+    // table reference
+    relation = catalog.table(n->name).live();
+    producedRelation = true;
+}
+
+// visit int literal
+void Executor::visit(const Node::IntLiteral* n) {
+    value = Value(n->value);
+}
+
+// visit float literal
+void Executor::visit(const Node::FloatLiteral* n) {
+    value = Value(n->value);
+}
+
+// visit bool literal
+void Executor::visit(const Node::BoolLiteral* n) {
+    value = Value(n->value);
+}
+
+// visit chars literal
+void Executor::visit(const Node::CharsLiteral* n) {
+    value = Value(std::string(n->value));
+}
+
+// visit parameter
+void Executor::visit(const Node::Parameter* n) {
+    value = (*parameters)[n->index - 1];
+}
+
+// visit select expression
+void Executor::visit(const Node::SelectExpression* n) {
+    Pipeline pipeline;
+    compilePipeline(n, pipeline);
+    relation = runPipeline(pipeline);
+    producedRelation = true;
+}
+
+// visit project expression
+void Executor::visit(const Node::ProjectExpression* n) {
+    Pipeline pipeline;
+    compilePipeline(n, pipeline);
+    relation = runPipeline(pipeline);
+    producedRelation = true;
+}
+
+// visit column list
+void Executor::visit(const Node::ColumnList* n) {}
+
+// visit union expression
+void Executor::visit(const Node::UnionExpression* n) {
+    n->LHS->accept(this);
+    Table left = std::move(relation);
+    n->RHS->accept(this);
+    Table right = std::move(relation);
+    if (!left.isUnionCompatible(right)) {
+        executionError("Operands of | are not union compatible.");
+    }
+
+    // set semantics
+    Table output;
+    output.columns = left.columns;
+    std::unordered_set<Row, RowHash> seen;
+    for (auto* input : {&left, &right}) {
+        for (auto& current : input->rows) {
+            if (seen.insert(current).second) {
+                output.rows.push_back(std::move(current));
+            }
+        }
+    }
+
+    relation = std::move(output);
+    producedRelation = true;
+}
+
+// visit difference expression
+void Executor::visit(const Node::DifferenceExpression* n) {
+    n->LHS->accept(this);
+    Table left = std::move(relation);
+    n->RHS->accept(this);
+    Table right = std::move(relation);
+    if (!left.isUnionCompatible(right)) {
+        executionError("Operands of - are not union compatible.");
+    }
+
+    // set semantics
+    std::unordered_set<Row, RowHash> seen(right.rows.begin(), right.rows.end());
+    Table output;
+    output.columns = left.columns;
+    for (auto& current : left.rows) {
+        if (seen.insert(current).second) {
+            output.rows.push_back(std::move(current));
+        }
+    }
+
+    relation = std::move(output);
+    producedRelation = true;
+}
+
+// visit intersect expression
+void Executor::visit(const Node::IntersectExpression* n) {
+    n->LHS->accept(this);
+    Table left = std::move(relation);
+    n->RHS->accept(this);
+    Table right = std::move(relation);
+    if (!left.isUnionCompatible(right)) {
+        executionError("Operands of & are not union compatible.");
+    }
+
+    // set semantics
+    std::unordered_set<Row, RowHash> candidates(right.rows.begin(), right.rows.end());
+    Table output;
+    output.columns = left.columns;
+    for (auto& current : left.rows) {
+        if (candidates.erase(current)) {
+            output.rows.push_back(std::move(current));
+        }
+    }
+
+    relation = std::move(output);
+    producedRelation = true;
+}
+
+// visit join expression
+void Executor::visit(const Node::JoinExpression* n) {
+    Pipeline pipeline;
+    compilePipeline(n, pipeline);
+    relation = runPipeline(pipeline);
+    producedRelation = true;
+}
@@ -0,0 +1,383 @@
+// FlatAst.cpp
+
+#include <fstream>
+#include "microRDB/FlatAst.hpp"
+#include "microRDB/Visitor.hpp"
+
+namespace {
+    // appends nodes in preorder, children opened since a node was opened become its children
+    class FlatAstBuilder : public Visitor {
+    private:
+        FlatAst& ast;
+        Arena& textArena;
+        std::vector<uint32_t> pending;
+
+        uint32_t open(FlatNode::Kind kind) {
+            uint32_t self = ast.nodes.size();
+            ast.nodes.push_back(FlatNode(kind));
+            pending.push_back(self);
+            return self;
+        }
+
+        // the first text added to a node is where its strings start
+        void addText(uint32_t self, std::string_view text, bool first = true) {
+            if (first) {
+                ast.nodes[self].text = ast.strings.size();
+            }
+            ast.strings.push_back(text);
+        }
+
+        void close(uint32_t self, size_t start) {
+            FlatNode& node = ast.nodes[self];
+            node.firstChild = ast.children.size();
+            node.numChildren = pending.size() - start;
+            ast.children.insert(ast.children.end(), pending.begin() + start, pending.end());
+            pending.resize(start);
+            node.end = ast.nodes.size();
+        }
+
+        void leaf(FlatNode::Kind kind, std::string_view text) {
+            uint32_t self = open(kind);
+            addText(self, text);
+            close(self, pending.size());
+        }
+
+        void binary(FlatNode::Kind kind, const Node::Node* LHS, const Node::Node* RHS, Node::Operator op = Node::opEquals) {
+            uint32_t self = open(kind);
+            ast.nodes[self].op = op;
+            size_t start = pending.size();
+            LHS->accept(this);
+            RHS->accept(this);
+            close(self, start);
+        }
+
+        template <typename T>
+        void list(FlatNode::Kind kind, const Node::List<T>& items) {
+            uint32_t self = open(kind);
+            size_t start = pending.size();
+            for (const auto& item : items) {
+                item->accept(this);
+            }
+            close(self, start);
+        }
+
+    public:
+        FlatAstBuilder(FlatAst& ast, Arena& textArena)
+            : ast(ast), textArena(textArena) {}
+
+        // visit script
+        void visit(const Node::Script* n) override {
+            uint32_t self = open(FlatNode::script);
+            size_t start = pending.size();
+            for (const auto& statement : n->statements) {
+                statement->accept(this);
+            }
+            close(self, start);
+        }
+
+        // visit create
+        void visit(const Node::Create* n) override {
+            uint32_t self = open(FlatNode::create);
+            ast.nodes[self].boolValue = n->maintained;
+            addText(self, n->tableName);
+            size_t start = pending.size();
+            n->expression->accept(this);
+            close(self, start);
+        }
+
+        // visit name-type list
+        void visit(const Node::NameTypeList* n) override {
+            list(FlatNode::nameTypeList, n->nameTypePairs);
+        }
+
+        // visit name-type pair
+        void visit(const Node::NameTypePair* n) override {
+            uint32_t self = open(FlatNode::nameTypePair);
+            addText(self, n->name);
+            addText(self, n->type, false);
+            addText(self, n->numChars, false);
+            close(self, pending.size());
+        }
+
+        // visit drop
+        void visit(const Node::Drop* n) override {
+            leaf(FlatNode::drop, n->tableName);
+        }
+
+        // visit analyze
+        void visit(const Node::Analyze* n) override {
+            leaf(FlatNode::analyze, n->tableName);
+        }
+
+        // visit delete
+        void visit(const Node::Delete* n) override {
+            uint32_t self = open(FlatNode::deleteStatement);
+            addText(self, n->tableName);
+            size_t start = pending.size();
+            for (const auto& filter : n->filters) {
+                filter->accept(this);
+            }
+            close(self, start);
+        }
+
+        // visit filter
+        void visit(const Node::Filter* n) override {
+            uint32_t self = open(FlatNode::filter);
+            size_t start = pending.size();
+            n->expr->accept(this);
+            close(self, start);
+        }
+
+        // visit update, the assign list is the first child and the filters follow
+        void visit(const Node::Update* n) override {
+            uint32_t self = open(FlatNode::update);
+            addText(self, n->tableName);
+            size_t start = pending.size();
+            n->assignList->accept(this);
+            for (const auto& filter : n->filters) {
+                filter->accept(this);
+            }
+            close(self, start);
+        }
+
+        // visit assign list
+        void visit(const Node::AssignList* n) override {
+            list(FlatNode::assignList, n->assigns);
+        }
+
+        // visit assign
+        void visit(const Node::Assign* n) override {
+            uint32_t self = open(FlatNode::assign);
+            addText(self, n->name);
+            size_t start = pending.size();
+            n->expr->accept(this);
+            close(self, start);
+        }
+
+        // visit insert
+        void visit(const Node::Insert* n) override {
+            uint32_t self = open(FlatNode::insert);
+            addText(self, n->tableName);
+            size_t start = pending.size();
+            for (const auto& expressionList : n->expressionLists) {
+                expressionList->accept(this);
+            }
+            close(self, start);
+        }
+
+        // visit bulk insert, flattened like the insert it replaces
+        void visit(const Node::BulkInsert* n) override {
+            uint32_t self = open(FlatNode::insert);
+            addText(self, n->tableName);
+            size_t start = pending.size();
+            for (size_t r = 0; r < n->numRows; ++r) {
+                uint32_t list = open(FlatNode::expressionList);
+                size_t listStart = pending.size();
+                const Node::Literal* literals = n->row(r);
+                for (size_t c = 0; c < n->numColumns; ++c) {
+                    const Node::Literal& literal = literals[c];
+                    switch (literal.type) {
+                        case Node::Literal::intType:
+                            ast.nodes[open(FlatNode::intLiteral)].intValue = literal.intValue;
+                            break;
+                        case Node::Literal::floatType:
+                            ast.nodes[open(FlatNode::floatLiteral)].floatValue = literal.floatValue;
+                            break;
+                        case Node::Literal::boolType:
+                            ast.nodes[open(FlatNode::boolLiteral)].boolValue = literal.boolValue;
+                            break;
+                        case Node::Literal::charsType:
+                            addText(open(FlatNode::charsLiteral), textArena.copy(literal.charsValue));
+                            break;
+                    }
+                    close(ast.nodes.size() - 1, pending.size());
+                }
+                close(list, listStart);
+            }
+            close(self, start);
+        }
+
+        // visit load
+        void visit(const Node::Load* n) override {
+            uint32_t self = open(FlatNode::load);
+            addText(self, n->tableName);
+            addText(self, textArena.copy(n->path), false);
+            close(self, pending.size());
+        }
+
+        // visit expression list
+        void visit(const Node::ExpressionList* n) override {
+            list(FlatNode::expressionList, n->expressions);
+        }
+
+        // visit scalar expressions
+        void visit(const Node::OrExpression* n) override {
+            binary(FlatNode::orExpression, n->LHS.get(), n->RHS.get());
+        }
+
+        void visit(const Node::AndExpression* n) override {
+            binary(FlatNode::andExpression, n->LHS.get(), n->RHS.get());
+        }
+
+        void visit(const Node::EqualityExpression* n) override {
+            binary(FlatNode::equalityExpression, n->LHS.get(), n->RHS.get(), n->op);
+        }
+
+        void visit(const Node::RelationalExpression* n) override {
+            binary(FlatNode::relationalExpression, n->LHS.get(), n->RHS.get(), n->op);
+        }
+
+        void visit(const Node::AdditiveExpression* n) override {
+            binary(FlatNode::additiveExpression, n->LHS.get(), n->RHS.get(), n->op);
+        }
+
+        void visit(const Node::MultiplicativeExpression* n) override {
+            binary(FlatNode::multiplicativeExpression, n->LHS.get(), n->RHS.get(), n->op);
+        }
+
+        // visit identifier
+        void visit(const Node::Identifier* n) override {
+            leaf(FlatNode::identifier, n->name);
+        }
+
+        // visit literals
+        void visit(const Node::IntLiteral* n) override {
+            uint32_t self = open(FlatNode::intLiteral);
+            ast.nodes[self].intValue = n->value;
+            close(self, pending.size());
+        }
+
+        void visit(const Node::FloatLiteral* n) override {
+            uint32_t self = open(FlatNode::floatLiteral);
+            ast.nodes[self].floatValue = n->value;
+            close(self, pending.size());
+        }
+
+        void visit(const Node::BoolLiteral* n) override {
+            uint32_t self = open(FlatNode::boolLiteral);
+            ast.nodes[self].boolValue = n->value;
+            close(self, pending.size());
+        }
+
+        void visit(const Node::CharsLiteral* n) override {
+            leaf(FlatNode::charsLiteral, textArena.copy(n->value));
+        }
+
+        // visit parameter
+        void visit(const Node::Parameter* n) override {
+            uint32_t self = open(FlatNode::parameter);
+            ast.nodes[self].intValue = n->index;
+            close(self, pending.size());
+        }
+
+        // visit relational expressions
+        void visit(const Node::SelectExpression* n) override {
+            binary(FlatNode::selectExpression, n->LHS.get(), n->RHS.get());
+        }
+
+        void visit(const Node::ProjectExpression* n) override {
+            binary(FlatNode::projectExpression, n->LHS.get(), n->RHS.get());
+        }
+
+        void visit(const Node::ColumnList* n) override {
+            list(FlatNode::columnList, n->columns);
+        }
+
+        void visit(const Node::UnionExpression* n) override {
+            binary(FlatNode::unionExpression, n->LHS.get(), n->RHS.get());
+        }
+
+        void visit(const Node::DifferenceExpression* n) override {
+            binary(FlatNode::differenceExpression, n->LHS.get(), n->RHS.get());
+        }
+
+        void visit(const Node::IntersectExpression* n) override {
+            binary(FlatNode::intersectExpression, n->LHS.get(), n->RHS.get());
+        }
+
+        void visit(const Node::JoinExpression* n) override {
+            binary(FlatNode::joinExpression, n->LHS.get(), n->RHS.get());
+        }
+    };
+}
+
+FlatAst FlatAst::build(const Node::Script* script) {
+    FlatAst ast;
+    ast.textArena = std::make_unique<Arena>();
+    FlatAstBuilder builder(ast, *ast.textArena);
+    script->accept(&builder);
+    return ast;
+}
+
+void FlatAst::writeDot(const std::string& fileName) const {
+    std::ofstream dotFile(fileName);
+    dotFile << "graph G {\n";
+    if (!nodes.empty()) {
+        writeDot(dotFile, 0);
+    }
+    dotFile << "}\n";
+}
+
+void FlatAst::writeDot(std::ostream& out, uint32_t i) const {
+    const FlatNode& n = nodes[i];
+
+    // create this node, labels match DOTVisitor
+    out << "node" << i << " [label=\"";
+    switch (n.kind) {
+        case FlatNode::script: out << "program"; break;
+        case FlatNode::create: out << "create" << (n.boolValue ? " maintained" : "") << "\\n" << text(i); break;
+        case FlatNode::nameTypeList: out << "name-type list"; break;
+        case FlatNode::nameTypePair:
+            out << "name-type pair\\n" << text(i) << ":" << text(i, 1);
+            if (!text(i, 2).empty()) {
+                out << "(" << text(i, 2) << ")";
+            }
+            break;
+        case FlatNode::drop: out << "drop\\n" << text(i); break;
+        case FlatNode::analyze: out << "analyze\n" << text(i); break;
+        case FlatNode::deleteStatement: out << "delete\\n" << text(i); break;
+        case FlatNode::filter: out << "filter"; break;
+        case FlatNode::update: out << "update\\n" << text(i); break;
+        case FlatNode::assignList: out << "assign list"; break;
+        case FlatNode::assign: out << "assign\\n" << text(i); break;
+        case FlatNode::insert: out << "insert\\n" << text(i); break;
+        case FlatNode::expressionList: out << "expression list"; break;
+        case FlatNode::orExpression: out << "||"; break;
+        case FlatNode::andExpression: out << "&&"; break;
+        case FlatNode::equalityExpression:
+        case FlatNode::relationalExpression:
+        case FlatNode::additiveExpression:
+        case FlatNode::multiplicativeExpression: out << Node::operatorString(n.op); break;
+        case FlatNode::identifier: out << "identifier\\n" << text(i); break;
+        case FlatNode::intLiteral: out << "int literal\\n" << std::to_string(n.intValue); break;
+        case FlatNode::floatLiteral: out << "float literal\\n" << std::to_string(n.floatValue); break;
+        case FlatNode::boolLiteral: out << "bool literal\\n" << (n.boolValue ? "true" : "false"); break;
+        case FlatNode::charsLiteral: out << "chars literal\\n" << text(i); break;
+        case FlatNode::selectExpression: out << "select expression"; break;
+        case FlatNode::projectExpression: out << "project expression"; break;
+        case FlatNode::columnList: out << "column list"; break;
+        case FlatNode::unionExpression: out << "union expression"; break;
+        case FlatNode::differenceExpression: out << "difference expression"; break;
+        case FlatNode::intersectExpression: out << "intersect expression"; break;
+        case FlatNode::joinExpression: out << "join expression"; break;
+        case FlatNode::parameter: out << "parameter\\n$" << std::to_string(n.intValue); break;
+        case FlatNode::load: out << "load\\n" << text(i) << "\\n" << text(i, 1); break;
+    }
+    out << "\"];\n";
+
+    // process children, then connect them to this node
+    // update connects its assign list before processing its filters
+    auto childIds = childrenOf(i);
+    size_t k = 0;
+    if (n.kind == FlatNode::update) {
+        writeDot(out, childIds[0]);
+        out << "node" << i << " -- node" << childIds[0] << ";\n";
+        k = 1;
+    }
+    for (size_t c = k; c < childIds.size(); ++c) {
+        writeDot(out, childIds[c]);
+    }
+    for (size_t c = k; c < childIds.size(); ++c) {
+        out << "node" << i << " -- node" << childIds[c] << ";\n";
+    }
+}
@@ -0,0 +1,231 @@
+// GenericJoin.cpp
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include "microRDB/GenericJoin.hpp"
+
+GenericJoin::GenericJoin(const std::vector<const Table*>& inputs, const std::vector<std::string>& outputColumns) {
+    // variables are the distinct column names, first appearance order
+    std::vector<size_t> occurrences;
+    for (const auto* input : inputs) {
+        for (const auto& column : input->columns) {
+            auto found = std::find(variables.begin(), variables.end(), column.name);
+            if (found == variables.end()) {
+                variables.push_back(column.name);
+                variableTypes.push_back(column.type);
+                variableNumChars.push_back(column.numChars);
+                occurrences.push_back(1);
+                continue;
+            }
+
+            size_t v = found - variables.begin();
+            if (variableTypes[v] != column.type) {
+                std::cout << "Execution error. Join column \"" << column.name << "\" has mismatched types. Terminating.\n";
+                exit(1);
+            }
+            ++occurrences[v];
+        }
+    }
+
+    // most constrained variables first, they prune the most
+    std::vector<size_t> order(variables.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return occurrences[a] > occurrences[b];
+    });
+    std::vector<std::string> orderedVariables;
+    std::vector<Value::Type> orderedTypes;
+    std::vector<size_t> orderedNumChars;
+    for (auto v : order) {
+        orderedVariables.push_back(variables[v]);
+        orderedTypes.push_back(variableTypes[v]);
+        orderedNumChars.push_back(variableNumChars[v]);
+    }
+    variables = std::move(orderedVariables);
+    variableTypes = std::move(orderedTypes);
+    variableNumChars = std::move(orderedNumChars);
+    relationsByVariable.resize(variables.size());
+
+    // sort every input by its columns in variable order, collapsing duplicates into counts
+    for (const auto* input : inputs) {
+        Relation relation;
+        // a variable's index in the reordered variables is its rank
+        std::vector<size_t> columns(input->columns.size());
+        std::vector<size_t> variableOf(input->columns.size());
+        std::iota(columns.begin(), columns.end(), 0);
+        for (size_t c = 0; c < columns.size(); ++c) {
+            variableOf[c] = std::find(variables.begin(), variables.end(), input->columns[c].name) - variables.begin();
+        }
+        std::sort(columns.begin(), columns.end(), [&](size_t a, size_t b) { return variableOf[a] < variableOf[b]; });
+        for (auto c : columns) {
+            relation.variables.push_back(variableOf[c]);
+        }
+
+        std::vector<Row> tuples;
+        tuples.reserve(input->rows.size() - input->deleted.count());
+        for (size_t r = input->deleted.nextLive(0); r < input->rows.size(); r = input->deleted.nextLive(r + 1)) {
+            Row tuple;
+            tuple.reserve(columns.size());
+            for (auto c : columns) {
+                tuple.push_back(input->rows[r][c]);
+            }
+            tuples.push_back(std::move(tuple));
+        }
+        std::sort(tuples.begin(), tuples.end());
+
+        for (auto& tuple : tuples) {
+            if (!relation.tuples.empty() && relation.tuples.back() == tuple) {
+                ++relation.counts.back();
+                continue;
+            }
+            relation.tuples.push_back(std::move(tuple));
+            relation.counts.push_back(1);
+        }
+        relation.hi = relation.tuples.size();
+
+        size_t r = relations.size();
+        for (size_t position = 0; position < relation.variables.size(); ++position) {
+            relationsByVariable[relation.variables[position]].push_back({r, position});
+        }
+        relations.push_back(std::move(relation));
+    }
+
+    for (const auto& name : outputColumns) {
+        size_t v = std::find(variables.begin(), variables.end(), name) - variables.begin();
+        outputVariables.push_back(v);
+        output.columns.push_back(Column(name, variableTypes[v], variableNumChars[v]));
+    }
+    binding.resize(variables.size());
+}
+
+Table GenericJoin::execute() {
+    output.rows.clear();
+    join(0);
+    return std::move(output);
+}
+
+void GenericJoin::join(size_t variable) {
+    if (variable == variables.size()) {
+        emit();
+        return;
+    }
+
+    const auto& participants = relationsByVariable[variable];
+
+    // value of a participant's column at the given tuple index
+    auto valueAt = [&](size_t p, size_t index) -> const Value& {
+        return relations[participants[p].first].tuples[index][participants[p].second];
+    };
+
+    // leapfrog: every participant's range is sorted on this column since its earlier columns are bound
+    std::vector<size_t> positions;
+    std::vector<std::pair<size_t, size_t>> saved;
+    for (const auto& participant : participants) {
+        const Relation& relation = relations[participant.first];
+        if (relation.lo == relation.hi) {
+            return;
+        }
+        positions.push_back(relation.lo);
+        saved.push_back({relation.lo, relation.hi});
+    }
+
+    while (true) {
+        // candidate is the largest current value
+        size_t largest = 0;
+        for (size_t p = 1; p < participants.size(); ++p) {
+            if (valueAt(largest, positions[largest]) < valueAt(p, positions[p])) {
+                largest = p;
+            }
+        }
+        Value candidate = valueAt(largest, positions[largest]);
+
+        // seek everyone to the candidate
+        bool allMatch = true;
+        for (size_t p = 0; p < participants.size(); ++p) {
+            const Relation& relation = relations[participants[p].first];
+            size_t column = participants[p].second;
+            auto begin = relation.tuples.begin() + positions[p];
+            auto end = relation.tuples.begin() + saved[p].second;
+            auto seek = std::lower_bound(begin, end, candidate, [column](const Row& tuple, const Value& v) {
+                return tuple[column] < v;
+            });
+            positions[p] = seek - relation.tuples.begin();
+            if (positions[p] == saved[p].second) {
+                allMatch = false;
+                break;
+            }
+            if (relation.tuples[positions[p]][column] != candidate) {
+                allMatch = false;
+            }
+        }
+
+        // some participant ran out
+        bool exhausted = false;
+        for (size_t p = 0; p < participants.size(); ++p) {
+            if (positions[p] == saved[p].second) {
+                exhausted = true;
+            }
+        }
+        if (exhausted) {
+            break;
+        }
+        if (!allMatch) {
+            continue;
+        }
+
+        // narrow every participant to the candidate and bind the next variable
+        std::vector<size_t> ends;
+        for (size_t p = 0; p < participants.size(); ++p) {
+            Relation& relation = relations[participants[p].first];
+            size_t column = participants[p].second;
+            auto begin = relation.tuples.begin() + positions[p];
+            auto end = relation.tuples.begin() + saved[p].second;
+            auto upper = std::upper_bound(begin, end, candidate, [column](const Value& v, const Row& tuple) {
+                return v < tuple[column];
+            });
+            ends.push_back(upper - relation.tuples.begin());
+            relation.lo = positions[p];
+            relation.hi = ends.back();
+        }
+
+        binding[variable] = candidate;
+        join(variable + 1);
+
+        for (size_t p = 0; p < participants.size(); ++p) {
+            positions[p] = ends[p];
+        }
+        bool done = false;
+        for (size_t p = 0; p < participants.size(); ++p) {
+            if (positions[p] == saved[p].second) {
+                done = true;
+            }
+        }
+        if (done) {
+            break;
+        }
+    }
+
+    for (size_t p = 0; p < participants.size(); ++p) {
+        relations[participants[p].first].lo = saved[p].first;
+        relations[participants[p].first].hi = saved[p].second;
+    }
+}
+
+void GenericJoin::emit() {
+    // every relation is narrowed to exactly one distinct tuple
+    size_t multiplicity = 1;
+    for (const auto& relation : relations) {
+        multiplicity *= relation.counts[relation.lo];
+    }
+
+    Row row;
+    row.reserve(outputVariables.size());
+    for (auto v : outputVariables) {
+        row.push_back(binding[v]);
+    }
+    for (size_t i = 1; i < multiplicity; ++i) {
+        output.rows.push_back(row);
+    }
+    output.rows.push_back(std::move(row));
+}
@@ -0,0 +1,402 @@
+// IncrementalView.cpp
+
+#include <algorithm>
+#include "microRDB/Catalog.hpp"
+#include "microRDB/IncrementalView.hpp"
+#include "microRDB/Visitor.hpp"
+
+namespace {
+    int ordinalOf(const std::vector<Column>& columns, const std::string& name) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (columns[i].name == name) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    long countOf(const ZSet& zset, const Row& row) {
+        auto found = zset.find(row);
+        return found == zset.end() ? 0 : found->second;
+    }
+
+    // values of row at the given ordinals
+    Row keyOf(const Row& row, const std::vector<size_t>& key) {
+        Row values;
+        values.reserve(key.size());
+        for (auto ordinal : key) {
+            values.push_back(row[ordinal]);
+        }
+        return values;
+    }
+
+    // left row followed by the right row's columns the left does not have
+    Row joinRows(const Row& left, const Row& right, const std::vector<size_t>& appended) {
+        Row joined = left;
+        joined.reserve(left.size() + appended.size());
+        for (auto ordinal : appended) {
+            joined.push_back(right[ordinal]);
+        }
+        return joined;
+    }
+
+    // plans a bound relational expression into delta operators
+    // select predicates are copied into the view's arena, the statement's tree does not outlive it
+    class DeltaPlanner : public Visitor {
+    private:
+        const Catalog& catalog;
+        const std::vector<Value>* parameters;
+        Arena& arena;
+        std::vector<std::string>& tables;
+        bool& stateful;
+
+        std::unique_ptr<DeltaNode> plan; // relational nodes
+        Node::Node* copy = nullptr; // scalar nodes
+        bool planningScalar = false;
+
+        std::unique_ptr<DeltaNode> binary(DeltaNode::Kind kind, const Node::Node* LHS, const Node::Node* RHS) {
+            auto node = std::make_unique<DeltaNode>(kind);
+            node->inputs.push_back(planRelation(LHS));
+            node->inputs.push_back(planRelation(RHS));
+            node->columns = node->inputs[0]->columns;
+            stateful = true;
+            return node;
+        }
+
+        // a copy keeps the binding and ordinals the binder gave the original
+        Node::Node* bound(Node::Node* copied, const Node::Node* original) {
+            copied->binding = original->binding;
+            return copied;
+        }
+
+    public:
+        DeltaPlanner(const Catalog& catalog, const std::vector<Value>* parameters, Arena& arena,
+                     std::vector<std::string>& tables, bool& stateful)
+            : catalog(catalog), parameters(parameters), arena(arena), tables(tables), stateful(stateful) {}
+
+        std::unique_ptr<DeltaNode> planRelation(const Node::Node* expr) {
+            expr->accept(this);
+            return std::move(plan);
+        }
+
+        Node::Node* copyScalar(const Node::Node* expr) {
+            bool outer = planningScalar;
+            planningScalar = true;
+            expr->accept(this);
+            planningScalar = outer;
+            return copy;
+        }
+
+        // a select expression never contains statements
+
+        // visit script
+        void visit(const Node::Script* n) override {}
+
+        // visit create
+        void visit(const Node::Create* n) override {}
+
+        // visit name-type list
+        void visit(const Node::NameTypeList* n) override {}
+
+        // visit name-type pair
+        void visit(const Node::NameTypePair* n) override {}
+
+        // visit drop
+        void visit(const Node::Drop* n) override {}
+
+        // visit analyze
+        void visit(const Node::Analyze* n) override {}
+
+        // visit delete
+        void visit(const Node::Delete* n) override {}
+
+        // visit filter
+        void visit(const Node::Filter* n) override {}
+
+        // visit update
+        void visit(const Node::Update* n) override {}
+
+        // visit assign list
+        void visit(const Node::AssignList* n) override {}
+
+        // visit assign
+        void visit(const Node::Assign* n) override {}
+
+        // visit insert
+        void visit(const Node::Insert* n) override {}
+
+        // visit bulk insert
+        void visit(const Node::BulkInsert* n) override {}
+
+        // visit load
+        void visit(const Node::Load* n) override {}
+
+        // visit expression list
+        void visit(const Node::ExpressionList* n) override {}
+
+        // visit or expression
+        void visit(const Node::OrExpression* n) override {
+            copy = bound(arena.make<Node::OrExpression>(copyScalar(n->LHS.get()), copyScalar(n->RHS.get())), n);
+        }
+
+        // visit and expression
+        void visit(const Node::AndExpression* n) override {
+            copy = bound(arena.make<Node::AndExpression>(copyScalar(n->LHS.get()), copyScalar(n->RHS.get())), n);
+        }
+
+        // visit equality expression
+        void visit(const Node::EqualityExpression* n) override {
+            copy = bound(arena.make<Node::EqualityExpression>(copyScalar(n->LHS.get()), copyScalar(n->RHS.get()), n->op), n);
+        }
+
+        // visit relational expression
+        void visit(const Node::RelationalExpression* n) override {
+            copy = bound(arena.make<Node::RelationalExpression>(copyScalar(n->LHS.get()), copyScalar(n->RHS.get()), n->op), n);
+        }
+
+        // visit additive expression
+        void visit(const Node::AdditiveExpression* n) override {
+            copy = bound(arena.make<Node::AdditiveExpression>(copyScalar(n->LHS.get()), copyScalar(n->RHS.get()), n->op), n);
+        }
+
+        // visit multiplicative expression
+        void visit(const Node::MultiplicativeExpression* n) override {
+            copy = bound(arena.make<Node::MultiplicativeExpression>(copyScalar(n->LHS.get()), copyScalar(n->RHS.get()), n->op), n);
+        }
+
+        // visit identifier
+        void visit(const Node::Identifier* n) override {
+            // column reference
+            if (planningScalar) {
+                auto* column = arena.make<Node::Identifier>(n->name);
+                column->ordinal = n->ordinal;
+                copy = bound(column, n);
+                return;
+            }
+
+            // table reference
+            plan = std::make_unique<DeltaNode>(DeltaNode::scan);
+            plan->tableName = n->name;
+            plan->columns = catalog.table(n->name).columns;
+            if (std::find(tables.begin(), tables.end(), n->name) == tables.end()) {
+                tables.push_back(n->name);
+            }
+        }
+
+        // visit int literal
+        void visit(const Node::IntLiteral* n) override {
+            copy = bound(arena.make<Node::IntLiteral>(n->value), n);
+        }
+
+        // visit float literal
+        void visit(const Node::FloatLiteral* n) override {
+            copy = bound(arena.make<Node::FloatLiteral>(n->value), n);
+        }
+
+        // visit bool literal
+        void visit(const Node::BoolLiteral* n) override {
+            copy = bound(arena.make<Node::BoolLiteral>(n->value), n);
+        }
+
+        // visit chars literal
+        void visit(const Node::CharsLiteral* n) override {
+            copy = bound(arena.make<Node::CharsLiteral>(arena.copy(n->value)), n);
+        }
+
+        // visit parameter
+        void visit(const Node::Parameter* n) override {
+            // the view keeps the value the parameter had when it was created
+            const Value& v = (*parameters)[n->index - 1];
+            switch (v.type) {
+                case Value::intType: copy = arena.make<Node::IntLiteral>(v.intValue); break;
+                case Value::floatType: copy = arena.make<Node::FloatLiteral>(v.floatValue); break;
+                case Value::boolType: copy = arena.make<Node::BoolLiteral>(v.boolValue); break;
+                case Value::charsType: copy = arena.make<Node::CharsLiteral>(arena.copy(v.charsValue)); break;
+            }
+            bound(copy, n);
+        }
+
+        // visit select expression
+        void visit(const Node::SelectExpression* n) override {
+            auto node = std::make_unique<DeltaNode>(DeltaNode::select);
+            node->inputs.push_back(planRelation(n->LHS.get()));
+            node->columns = node->inputs[0]->columns;
+            node->predicate = copyScalar(n->RHS.get());
+            plan = std::move(node);
+        }
+
+        // visit project expression
+        void visit(const Node::ProjectExpression* n) override {
+            auto node = std::make_unique<DeltaNode>(DeltaNode::project);
+            node->inputs.push_back(planRelation(n->LHS.get()));
+            const std::vector<Column>& input = node->inputs[0]->columns;
+            for (const auto& column : static_cast<const Node::ColumnList*>(n->RHS.get())->columns) {
+                size_t ordinal = ordinalOf(input, column->name);
+                node->ordinals.push_back(ordinal);
+                node->columns.push_back(input[ordinal]);
+            }
+            plan = std::move(node);
+        }
+
+        // visit column list
+        void visit(const Node::ColumnList* n) override {}
+
+        // visit union expression
+        void visit(const Node::UnionExpression* n) override {
+            plan = binary(DeltaNode::unite, n->LHS.get(), n->RHS.get());
+        }
+
+        // visit difference expression
+        void visit(const Node::DifferenceExpression* n) override {
+            plan = binary(DeltaNode::difference, n->LHS.get(), n->RHS.get());
+        }
+
+        // visit intersect expression
+        void visit(const Node::IntersectExpression* n) override {
+            plan = binary(DeltaNode::intersect, n->LHS.get(), n->RHS.get());
+        }
+
+        // visit join expression
+        void visit(const Node::JoinExpression* n) override {
+            // natural join, nesting binary joins gives the columns in the order of the whole ^ chain
+            auto node = binary(DeltaNode::join, n->LHS.get(), n->RHS.get());
+            const std::vector<Column>& right = node->inputs[1]->columns;
+            for (size_t r = 0; r < right.size(); ++r) {
+                int l = ordinalOf(node->columns, right[r].name);
+                if (l == -1) {
+                    node->ordinals.push_back(r);
+                    node->columns.push_back(right[r]);
+                }
+                else {
+                    node->leftKey.push_back(l);
+                    node->rightKey.push_back(r);
+                }
+            }
+            plan = std::move(node);
+        }
+    };
+}
+
+IncrementalView::IncrementalView(const Node::Node* definition, const Catalog& catalog, const std::vector<Value>* parameters)
+    : arena(std::make_unique<Arena>()) {
+    DeltaPlanner planner(catalog, parameters, *arena, tables, stateful);
+    root = planner.planRelation(definition);
+}
+
+void IncrementalView::initialize(const Catalog& catalog, const Condition& condition) {
+    // selects and projects keep no state
+    if (!stateful) {
+        return;
+    }
+
+    // as if every source table had been filled after the view was created, one table at a time
+    for (const auto& table : tables) {
+        ZSet rows;
+        const Table& source = catalog.table(table);
+        for (size_t r = source.deleted.nextLive(0); r < source.rows.size(); r = source.deleted.nextLive(r + 1)) {
+            accumulate(rows, source.rows[r], 1);
+        }
+        propagate(*root, table, rows, condition);
+    }
+}
+
+ZSet IncrementalView::propagate(const std::string& table, const ZSet& change, const Condition& condition) {
+    return propagate(*root, table, change, condition);
+}
+
+ZSet IncrementalView::propagate(DeltaNode& node, const std::string& table, const ZSet& change, const Condition& condition) {
+    switch (node.kind) {
+        case DeltaNode::scan:
+            return node.tableName == table ? change : ZSet();
+
+        case DeltaNode::select: {
+            ZSet delta = propagate(*node.inputs[0], table, change, condition);
+            for (auto it = delta.begin(); it != delta.end();) {
+                it = condition(node.predicate, it->first) ? std::next(it) : delta.erase(it);
+            }
+            return delta;
+        }
+
+        case DeltaNode::project: {
+            ZSet delta;
+            for (const auto& [row, weight] : propagate(*node.inputs[0], table, change, condition)) {
+                accumulate(delta, keyOf(row, node.ordinals), weight);
+            }
+            return delta;
+        }
+
+        case DeltaNode::unite:
+        case DeltaNode::difference:
+        case DeltaNode::intersect: {
+            ZSet changes[2] = {propagate(*node.inputs[0], table, change, condition),
+                               propagate(*node.inputs[1], table, change, condition)};
+
+            // set semantics, a row is in the output or not depending on which inputs hold it
+            auto present = [&](const Row& row) {
+                bool left = countOf(node.counts[0], row) > 0;
+                bool right = countOf(node.counts[1], row) > 0;
+                if (node.kind == DeltaNode::unite) return left || right;
+                if (node.kind == DeltaNode::intersect) return left && right;
+                return left && !right;
+            };
+
+            ZSet delta;
+            for (int side = 0; side < 2; ++side) {
+                for (const auto& [row, weight] : changes[side]) {
+                    // rows changed on both sides are handled once, from the left
+                    if (side == 1 && changes[0].count(row) > 0) {
+                        continue;
+                    }
+                    bool before = present(row);
+                    accumulate(node.counts[0], row, countOf(changes[0], row));
+                    accumulate(node.counts[1], row, countOf(changes[1], row));
+                    bool after = present(row);
+                    accumulate(delta, row, long(after) - long(before));
+                }
+            }
+            return delta;
+        }
+
+        case DeltaNode::join: {
+            ZSet left = propagate(*node.inputs[0], table, change, condition);
+            ZSet right = propagate(*node.inputs[1], table, change, condition);
+
+            // d(L ^ R) = dL ^ R + (L + dL) ^ dR
+            ZSet delta;
+            for (const auto& [l, w] : left) {
+                auto found = node.indexes[1].find(keyOf(l, node.leftKey));
+                if (found != node.indexes[1].end()) {
+                    for (const auto& [r, v] : found->second) {
+                        accumulate(delta, joinRows(l, r, node.ordinals), w * v);
+                    }
+                }
+            }
+            for (const auto& [l, w] : left) {
+                Row key = keyOf(l, node.leftKey);
+                ZSet& bucket = node.indexes[0][key];
+                accumulate(bucket, l, w);
+                if (bucket.empty()) {
+                    node.indexes[0].erase(key);
+                }
+            }
+            for (const auto& [r, v] : right) {
+                auto found = node.indexes[0].find(keyOf(r, node.rightKey));
+                if (found != node.indexes[0].end()) {
+                    for (const auto& [l, w] : found->second) {
+                        accumulate(delta, joinRows(l, r, node.ordinals), w * v);
+                    }
+                }
+            }
+            for (const auto& [r, v] : right) {
+                Row key = keyOf(r, node.rightKey);
+                ZSet& bucket = node.indexes[1][key];
+                accumulate(bucket, r, v);
+                if (bucket.empty()) {
+                    node.indexes[1].erase(key);
+                }
+            }
+            return delta;
+        }
+    }
+    return ZSet();
+}
@@ -0,0 +1,168 @@
+// JoinOrderer.cpp
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include "microRDB/JoinOrderer.hpp"
+
+std::string JoinPlan::toString(const std::vector<std::string>& leafNames) const {
+    if (leaf != -1) {
+        return leafNames[leaf];
+    }
+
+    std::string buildString = build->toString(leafNames);
+    std::string probeString = probe->toString(leafNames);
+    if (build->leaf == -1) {
+        buildString = "(" + buildString + ")";
+    }
+    if (probe->leaf == -1) {
+        probeString = "(" + probeString + ")";
+    }
+    return buildString + " ^ " + probeString;
+}
+
+std::unique_ptr<JoinPlan> JoinOrderer::join(std::unique_ptr<JoinPlan> a, std::unique_ptr<JoinPlan> b) {
+    RelationEstimate estimate = CardinalityEstimator::estimateJoin(a->estimate, b->estimate);
+    double cost = a->cost + b->cost + estimate.rows;
+    if (b->estimate.rows < a->estimate.rows) {
+        std::swap(a, b);
+    }
+    return std::make_unique<JoinPlan>(std::move(a), std::move(b), estimate, cost);
+}
+
+bool JoinOrderer::isCyclic(const std::vector<RelationEstimate>& leaves) {
+    std::vector<std::set<std::string>> edges;
+    for (const auto& leaf : leaves) {
+        edges.push_back(std::set<std::string>(leaf.columns.begin(), leaf.columns.end()));
+    }
+
+    bool changed = true;
+    while (changed && edges.size() > 1) {
+        changed = false;
+
+        // drop columns that appear in a single edge
+        for (auto& edge : edges) {
+            for (auto column = edge.begin(); column != edge.end();) {
+                size_t appearances = 0;
+                for (const auto& other : edges) {
+                    appearances += other.count(*column);
+                }
+                if (appearances == 1) {
+                    column = edge.erase(column);
+                    changed = true;
+                }
+                else {
+                    ++column;
+                }
+            }
+        }
+
+        // drop edges contained in another edge
+        for (size_t i = 0; i < edges.size(); ++i) {
+            for (size_t j = 0; j < edges.size(); ++j) {
+                if (i != j && std::includes(edges[j].begin(), edges[j].end(), edges[i].begin(), edges[i].end())) {
+                    edges.erase(edges.begin() + i);
+                    changed = true;
+                    i = edges.size();
+                    break;
+                }
+            }
+        }
+    }
+
+    return edges.size() > 1;
+}
+
+std::unique_ptr<JoinPlan> JoinOrderer::order(const std::vector<RelationEstimate>& leaves) {
+    if (leaves.size() <= maxDynamicProgrammingLeaves) {
+        return orderDynamicProgramming(leaves);
+    }
+    return orderGreedy(leaves);
+}
+
+std::unique_ptr<JoinPlan> JoinOrderer::orderDynamicProgramming(const std::vector<RelationEstimate>& leaves) {
+    size_t n = leaves.size();
+    size_t full = (size_t(1) << n) - 1;
+
+    // best plan per subset of leaves, identified by the split that produced it
+    std::vector<RelationEstimate> estimates(full + 1);
+    std::vector<double> costs(full + 1, std::numeric_limits<double>::infinity());
+    std::vector<size_t> splits(full + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        estimates[size_t(1) << i] = leaves[i];
+        costs[size_t(1) << i] = 0.0;
+    }
+
+    // numeric order visits every subset after all of its proper subsets
+    for (size_t mask = 1; mask <= full; ++mask) {
+        if ((mask & (mask - 1)) == 0) {
+            continue;
+        }
+
+        for (size_t left = (mask - 1) & mask; left != 0; left = (left - 1) & mask) {
+            size_t right = mask ^ left;
+
+            // each unordered split once, build side is picked afterwards
+            if (left > right) {
+                continue;
+            }
+
+            RelationEstimate estimate = CardinalityEstimator::estimateJoin(estimates[left], estimates[right]);
+            double cost = costs[left] + costs[right] + estimate.rows;
+            if (cost < costs[mask]) {
+                costs[mask] = cost;
+                splits[mask] = left;
+                estimates[mask] = std::move(estimate);
+            }
+        }
+    }
+
+    // rebuild the tree from the recorded splits
+    struct Builder {
+        const std::vector<RelationEstimate>& leaves;
+        const std::vector<size_t>& splits;
+
+        std::unique_ptr<JoinPlan> build(size_t mask) const {
+            if ((mask & (mask - 1)) == 0) {
+                int leaf = 0;
+                while ((size_t(1) << leaf) != mask) {
+                    ++leaf;
+                }
+                return std::make_unique<JoinPlan>(leaf, leaves[leaf]);
+            }
+            return JoinOrderer::join(build(splits[mask]), build(mask ^ splits[mask]));
+        }
+    };
+
+    return Builder{leaves, splits}.build(full);
+}
+
+std::unique_ptr<JoinPlan> JoinOrderer::orderGreedy(const std::vector<RelationEstimate>& leaves) {
+    std::vector<std::unique_ptr<JoinPlan>> plans;
+    for (size_t i = 0; i < leaves.size(); ++i) {
+        plans.push_back(std::make_unique<JoinPlan>(i, leaves[i]));
+    }
+
+    // repeatedly join the pair with the smallest estimated result
+    while (plans.size() > 1) {
+        size_t bestI = 0;
+        size_t bestJ = 1;
+        double bestRows = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < plans.size(); ++i) {
+            for (size_t j = i + 1; j < plans.size(); ++j) {
+                double rows = CardinalityEstimator::estimateJoin(plans[i]->estimate, plans[j]->estimate).rows;
+                if (rows < bestRows) {
+                    bestRows = rows;
+                    bestI = i;
+                    bestJ = j;
+                }
+            }
+        }
+
+        auto joined = join(std::move(plans[bestI]), std::move(plans[bestJ]));
+        plans.erase(plans.begin() + bestJ);
+        plans[bestI] = std::move(joined);
+    }
+
+    return std::move(plans.front());
+}
@@ -1,12 +1,22 @@
 // Lexer.cpp
 
+#include <algorithm>
+#include <charconv>
 #include <iostream>
-#include <bitset>
-#include <unordered_map>
 #include "microRDB/Lexer.hpp"
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 namespace {
-    std::unordered_map<std::string, Token::Type> keywordMap {
+    // constexpr perfect hash over the keywords: (first + last + 2 * length) % 8 is collision free
+    struct Keyword {
+        std::string_view word;
+        Token::Type type;
+    };
+
+    constexpr Keyword keywords[] = {
         {"int", Token::kwInt},
         {"float", Token::kwFloat},
         {"bool", Token::kwBool},
@@ -15,7 +25,36 @@ namespace {
         {"false", Token::kwFalse}
     };
 
-    bool isOpMinus(const Token type) {
+    constexpr size_t keywordHash(std::string_view word) {
+        return (size_t(word.front()) + size_t(word.back()) + 2 * word.size()) % 8;
+    }
+
+    struct KeywordTable {
+        Keyword slots[8] = {};
+        bool collisionFree = true;
+
+        constexpr KeywordTable() {
+            for (const auto& keyword : keywords) {
+                Keyword& slot = slots[keywordHash(keyword.word)];
+                collisionFree = collisionFree && slot.word.empty();
+                slot = keyword;
+            }
+        }
+    };
+
+    constexpr KeywordTable keywordTable;
+    static_assert(keywordTable.collisionFree, "keyword hash must be perfect");
+
+    // identifier if the word is not a keyword
+    Token::Type wordType(std::string_view word) {
+        if (word.size() < 3 || word.size() > 5) {
+            return Token::identifier;
+        }
+        const Keyword& slot = keywordTable.slots[keywordHash(word)];
+        return slot.word == word ? slot.type : Token::identifier;
+    }
+
+    bool isOpMinus(const Token::Type type) {
         // conditions that guarantee opMinus, anything else assumed negative number
         // last token is a straightforward determiner
         return (type == Token::closeParen
@@ -25,390 +64,354 @@ namespace {
             || type == Token::kwTrue
             || type == Token::kwFalse
             || type == Token::charsLiteral
+            || type == Token::sigil
             // @TODO:complete this condition
             // || tokens.back() == Token::
         );
     }
-}
 
-std::vector<Token> Lexer::lex(const std::string& text) {
-    // @TODO: bounds check with a peek method
-    // @TODO: determine proper bitset once grammar established
-    // const std::bitset<128> validCharacterMap("");
-    size_t currentLineNumber = 1;
-    std::vector<Token> tokens = {};
+    bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
 
-     // traverse input characters
-    auto it = text.cbegin();
-    while (it != text.cend()) {
+    bool isWordStart(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
 
-        // if (!validCharacterMap[(unsigned )(*it)]) {
-        //     std::cout << "Lexer error: Invalid character \"" << *it << "\" in line " << currentLineNumber << ". Terminating with exit code: 1.\n";
-        //     exit(1);
-        // }
+    bool isWord(char c) {
+        return isWordStart(c) || isDigit(c);
+    }
 
-        // whitespace
-        if (isspace(*it)) {
-
-            // @NOTE: condenses any number of sequential newlines into one token
-            // windows newline crlf
-            if (*it == '\r' && *(it+1) == '\n') {
-                while (isspace(*it)) {
-                    if (*it == '\r' && *(it+1) == '\n') {
-                        ++currentLineNumber;
-                        it += 2;
-                    }
-                    else {
-                        ++it;
-                    }
-                }
-                // tokens.push_back(Token(Token::terminator, "\\n", currentLineNumber));
-                continue;
-            }
-            // *nix 
-            else if (*it == '\n') {
-                while (isspace(*it)) {
-                    if (*it == '\n') { 
-                        ++currentLineNumber;
-                    }
-                    ++it;
-                }
-                // tokens.push_back(Token(Token::terminator, "\\n", currentLineNumber));
-                continue;
-            }
+    bool isSpace(char c) {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    // character classes the lexer skips runs of
+    enum CharClass {
+        spaceClass,
+        wordClass,
+        digitClass,
+        lineEndClass,
+        quoteClass,
+        statementClass, // characters that matter when splitting statements: ; " #
+    };
 
-            // ignore other whitespace
-            ++it;
-            continue;
+    template <CharClass cls>
+    bool inClass(char c) {
+        switch (cls) {
+            case spaceClass: return isSpace(c);
+            case wordClass: return isWord(c);
+            case digitClass: return isDigit(c);
+            case lineEndClass: return c == '\n' || c == '\r';
+            case quoteClass: return c == '\"';
+            case statementClass: return c == ';' || c == '\"' || c == '#';
         }
+        return false;
+    }
+
+    // the same classes over a block of bytes at once, one result bit per byte
+#if defined(__AVX2__)
+    #define LEXER_SIMD
+    using Block = __m256i;
+    constexpr size_t blockSize = 32;
+    Block load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    Block splat(char c) { return _mm256_set1_epi8(c); }
+    Block equal(Block a, Block b) { return _mm256_cmpeq_epi8(a, b); }
+    Block greater(Block a, Block b) { return _mm256_cmpgt_epi8(a, b); }
+    Block either(Block a, Block b) { return _mm256_or_si256(a, b); }
+    Block subtract(Block a, Block b) { return _mm256_sub_epi8(a, b); }
+    uint32_t bits(Block a) { return uint32_t(_mm256_movemask_epi8(a)); }
+#elif defined(__SSE2__)
+    #define LEXER_SIMD
+    using Block = __m128i;
+    constexpr size_t blockSize = 16;
+    Block load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    Block splat(char c) { return _mm_set1_epi8(c); }
+    Block equal(Block a, Block b) { return _mm_cmpeq_epi8(a, b); }
+    Block greater(Block a, Block b) { return _mm_cmpgt_epi8(a, b); }
+    Block either(Block a, Block b) { return _mm_or_si128(a, b); }
+    Block subtract(Block a, Block b) { return _mm_sub_epi8(a, b); }
+    uint32_t bits(Block a) { return uint32_t(_mm_movemask_epi8(a)); }
+#endif
+
+#ifdef LEXER_SIMD
+    constexpr uint32_t blockBits = blockSize == 32 ? ~uint32_t(0) : (uint32_t(1) << blockSize) - 1;
+
+    // lo <= byte <= hi, unsigned (byte - lo) < (hi - lo + 1) done as a signed compare
+    Block inRange(Block a, char lo, char hi) {
+        return greater(splat(char(hi - lo + 1 - 128)), subtract(subtract(a, splat(lo)), splat(char(-128))));
+    }
 
-        // comment
-        else if (*it == '#') {
-            // ignore until next newline or end of input
-            while (*it != '\r' && *it != '\n' && it != text.cend()) {
-                ++it;
+    template <CharClass cls>
+    uint32_t inClass(Block a) {
+        switch (cls) {
+            case spaceClass: return bits(either(equal(a, splat(' ')), inRange(a, '\t', '\r')));
+            case wordClass: {
+                // setting 0x20 folds upper case onto lower case and nothing else onto a-z
+                Block letters = inRange(either(a, splat(0x20)), 'a', 'z');
+                return bits(either(either(letters, inRange(a, '0', '9')), equal(a, splat('_'))));
             }
+            case digitClass: return bits(inRange(a, '0', '9'));
+            case lineEndClass: return bits(either(equal(a, splat('\n')), equal(a, splat('\r'))));
+            case quoteClass: return bits(equal(a, splat('\"')));
+            case statementClass: return bits(either(either(equal(a, splat(';')), equal(a, splat('\"'))), equal(a, splat('#'))));
+        }
+        return 0;
+    }
+#endif
+
+    // first index at or after i whose character's membership in cls is not member
+    // the first few characters are tested alone since most runs in a script are short
+    constexpr size_t scalarPrefix = 4;
+
+    template <CharClass cls, bool member>
+    size_t scan(std::string_view text, size_t i, bool vectorized) {
+        for (size_t n = 0; n < scalarPrefix; ++n, ++i) {
+            if (i >= text.size() || inClass<cls>(text[i]) != member) {
+                return i;
+            }
+        }
 
-            // text begins with a comment
-            if (tokens.empty()) {
-                while (isspace(*it)) {
-                    if (*it == '\n') {
-                        ++currentLineNumber;
-                    }
-                    ++it;
+#ifdef LEXER_SIMD
+        if (vectorized) {
+            for (; i + blockSize <= text.size(); i += blockSize) {
+                uint32_t matches = inClass<cls>(load(text.data() + i));
+                uint32_t stops = (member ? ~matches : matches) & blockBits;
+                if (stops != 0) {
+                    return i + __builtin_ctz(stops);
                 }
-                // tokens.push_back(Token(Token::terminator, "\\n", currentLineNumber));
             }
+        }
+#else
+        (void)vectorized;
+#endif
 
-            // if the most recent token was a terminator, prevent another from being made after the comment by ignoring all whitespace
-            // if (tokens.back() == Token::terminator) {
-            //     while (isspace(*it)) {
-            //         if (*it == '\n') {
-            //             ++currentLineNumber;
-            //         }
-            //         ++it;
-            //     }
-            // }
+        while (i < text.size() && inClass<cls>(text[i]) == member) {
+            ++i;
         }
+        return i;
+    }
 
-        // identifier or keyword
-        else if (isalpha(*it) || *it == '_') {
+    // end of a run of characters in cls
+    template <CharClass cls>
+    size_t skip(std::string_view text, size_t i, bool vectorized) {
+        return scan<cls, true>(text, i, vectorized);
+    }
 
-            std::string::const_iterator wordEnd = it;
-            while (isalnum(*wordEnd) || *wordEnd == '_') {        
-                ++wordEnd;
-            }
-            std::string word = std::string(it, wordEnd);
+    // next character in cls, or the end of text
+    template <CharClass cls>
+    size_t find(std::string_view text, size_t i, bool vectorized) {
+        return scan<cls, false>(text, i, vectorized);
+    }
+}
+
+std::vector<Token> Lexer::lex(const std::string& text) {
+    std::vector<Token> tokens;
+    for (const auto& view : lexViews(text)) {
+        tokens.push_back(Token(view.type, std::string(view.value), view.lineNumber));
+    }
+    return tokens;
+}
+
+size_t Lexer::findStatementEnd(std::string_view text, size_t from) const {
+    size_t i = from;
+    while (true) {
+        i = find<statementClass>(text, i, vectorized);
+        if (i == text.size()) {
+            return std::string_view::npos;
+        }
+
+        if (text[i] == ';') {
+            return i + 1;
+        }
 
-            // identifier found if not in keyword map
-            std::unordered_map<std::string, Token::Type>::const_iterator possibleKeyword = keywordMap.find(word);
-            if (possibleKeyword == keywordMap.end()) {
-                tokens.push_back(Token(Token::identifier, word, currentLineNumber));
+        // skip over chars literals and comments, a ; in either does not end the statement
+        if (text[i] == '\"') {
+            i = find<quoteClass>(text, i + 1, vectorized);
+            if (i == text.size()) {
+                return std::string_view::npos;
             }
-            // otherwise keyword
-            else {
-                tokens.push_back(Token(possibleKeyword->second, word, currentLineNumber));
+            ++i;
+        }
+        else {
+            i = find<lineEndClass>(text, i, vectorized);
+            if (i == text.size()) {
+                return std::string_view::npos;
             }
-            it = wordEnd;
+        }
+    }
+}
+
+std::vector<TokenView> Lexer::lexViews(std::string_view text, uint32_t firstLineNumber) {
+    uint32_t currentLineNumber = firstLineNumber;
+    std::vector<TokenView> tokens;
 
-            continue;
+    // generated insert scripts average a little over 3 characters per token
+    tokens.reserve(text.size() / 3 + 16);
+
+    // bounds checked lookahead
+    const size_t size = text.size();
+    auto peek = [&](size_t i) {
+        return i < size ? text[i] : '\0';
+    };
+
+    // single and double character tokens
+    auto emit = [&](Token::Type type, size_t& i, size_t length) {
+        tokens.push_back(TokenView(type, text.substr(i, length), currentLineNumber));
+        i += length;
+    };
+
+    // traverse input characters
+    size_t i = 0;
+    while (i < size) {
+        char c = text[i];
+
+        // whitespace
+        if (isSpace(c)) {
+            size_t spaceEnd = skip<spaceClass>(text, i, vectorized);
+            currentLineNumber += std::count(text.begin() + i, text.begin() + spaceEnd, '\n');
+            i = spaceEnd;
+        }
+
+        // comment, ignore until next newline or end of input
+        else if (c == '#') {
+            i = find<lineEndClass>(text, i, vectorized);
+        }
+
+        // identifier or keyword
+        else if (isWordStart(c)) {
+            size_t wordEnd = skip<wordClass>(text, i, vectorized);
+            std::string_view word = text.substr(i, wordEnd - i);
+            tokens.push_back(TokenView(wordType(word), word, currentLineNumber));
+            i = wordEnd;
         }
 
         // ->
-        else if (*it == '-' && *(it+1) == '>') {
-            tokens.push_back(Token(Token::arrowRight, "->", currentLineNumber));
-            it += 2;
-            continue;
+        else if (c == '-' && peek(i+1) == '>') {
+            emit(Token::arrowRight, i, 2);
         }
 
         // special case due to ambiguity between opMinus and a negative number
         // -
-        else if (*it == '-' && isOpMinus(tokens.back())) {
-            tokens.push_back(Token(Token::opMinus, "-", currentLineNumber));
-            ++it;
-            continue;
+        else if (c == '-' && !tokens.empty() && isOpMinus(tokens.back())) {
+            emit(Token::opMinus, i, 1);
         }
 
         // numeric
-        else if (isdigit(*it) || *it == '-') {
-            if (*it == '-' && !isdigit(*(it+1))) {
+        else if (isDigit(c) || c == '-') {
+            if (c == '-' && !isDigit(peek(i+1))) {
                 std::cout << "Lexer error on line " << currentLineNumber << ". '-' must be followed by a digit.\n";
                 exit(1);
             }
-            std::string::const_iterator numberEnd = it + 1;
-            while (isdigit(*numberEnd))
-                numberEnd++;
-            
-            // float
-            if (*numberEnd == '.') {
-
-                // float, b/c digit after .
-                ++numberEnd;
-                if (isdigit(*numberEnd)) {
-                    
-                    // expect only more digits
-                    while (isdigit(*numberEnd))
-                        numberEnd++;
-
-                    std::string number(it, numberEnd);
-                    tokens.push_back(Token(Token::floatLiteral, number, currentLineNumber));
-                    it = numberEnd;
-                }
-
-                // otherwise, the '.' is a dot operator
-                else {
-                    --numberEnd; // exclude the '.'
-                    std::string number(it, numberEnd);
-                    tokens.push_back(Token(Token::intLiteral, number, currentLineNumber));
-                    it = numberEnd;
-                }
+            size_t numberEnd = skip<digitClass>(text, i + 1, vectorized);
+
+            // float, b/c digit after .
+            // otherwise, the '.' is a dot operator
+            if (peek(numberEnd) == '.' && isDigit(peek(numberEnd+1))) {
+                numberEnd = skip<digitClass>(text, numberEnd + 1, vectorized);
+                tokens.push_back(TokenView(Token::floatLiteral, text.substr(i, numberEnd - i), currentLineNumber));
+                i = numberEnd;
                 continue;
             }
 
             // int
-            std::string number(it, numberEnd);
-            try {
-                std::stoi(number);
-            }
-            catch (const std::out_of_range& e) {
+            std::string_view number = text.substr(i, numberEnd - i);
+            int parsed;
+            if (std::from_chars(number.data(), number.data() + number.size(), parsed).ec == std::errc::result_out_of_range) {
                 std::cout << "Lexer error on line " << currentLineNumber << ". The integer " << number << " out of 32 bit int range.\n";
                 exit(1);
             }
-
-            tokens.push_back(Token(Token::intLiteral, number, currentLineNumber));
-            it = numberEnd;
-            continue;
+            tokens.push_back(TokenView(Token::intLiteral, number, currentLineNumber));
+            i = numberEnd;
         }
 
         // " string
-        else if (*it == '\"') {
-            std::string::const_iterator string_end = it;
-            string_end++; // consume "
-            while (*string_end != '\"' && string_end != text.end()) {
-                string_end++;
-            }
-
-            if (string_end == text.end()) {
+        else if (c == '\"') {
+            size_t stringEnd = find<quoteClass>(text, i + 1, vectorized);
+            if (stringEnd == size) {
                 std::cout << "Tokenizer error. Unpaired \" on line " << currentLineNumber << ".\n";
                 exit(1);
             }
-            string_end++; // consume ending "
-            
-            // discard the quotes
-            std::string string(it+1, string_end-1);
-            tokens.push_back(Token(Token::charsLiteral, string, currentLineNumber));
-            it = string_end;
-        }
 
-        // .
-        else if (*it == '.') {
-            tokens.push_back(Token(Token::dot, ".", currentLineNumber));
-            ++it;
-            continue;
+            // discard the quotes
+            tokens.push_back(TokenView(Token::charsLiteral, text.substr(i + 1, stringEnd - i - 1), currentLineNumber));
+            i = stringEnd + 1;
         }
 
-        // =, ==
-        else if (*it == '=') {
-            if (*(it+1) == '=') {
-                tokens.push_back(Token(Token::opEquals, "==", currentLineNumber));
-                it += 2;
-                continue;
+        // $1, $2, ... parameters
+        else if (c == '$') {
+            if (!isDigit(peek(i+1))) {
+                std::cout << "Lexer error on line " << currentLineNumber << ". '$' must be followed by a parameter number.\n";
+                exit(1);
             }
-
-            tokens.push_back(Token(Token::opAssign, "=", currentLineNumber));
-            ++it;
-            continue;
-        }
-
-        // +
-        else if (*it == '+') {
-            tokens.push_back(Token(Token::opPlus, "+", currentLineNumber));
-            ++it;
-            continue;
+            size_t parameterEnd = skip<digitClass>(text, i + 1, vectorized);
+            tokens.push_back(TokenView(Token::sigil, text.substr(i, parameterEnd - i), currentLineNumber));
+            i = parameterEnd;
         }
 
-        // *
-        else if (*it == '*') {
-            tokens.push_back(Token(Token::opMultiply, "*", currentLineNumber));
-            ++it;
-            continue;
-        }
-
-        // /
-        else if (*it == '/') {
-            tokens.push_back(Token(Token::opDivide, "/", currentLineNumber));
-            ++it;
-            continue;
-        }
-
-        // %
-        else if (*it == '%') {
-            tokens.push_back(Token(Token::opModulus, "%", currentLineNumber));
-            ++it;
-            continue;
+        // =, ==
+        else if (c == '=') {
+            peek(i+1) == '=' ? emit(Token::opEquals, i, 2) : emit(Token::opAssign, i, 1);
         }
 
         // &, &&
-        else if (*it == '&') {
-            if (*(it+1) == '&') {
-                tokens.push_back(Token(Token::opLogicalAnd, "&&", currentLineNumber));
-                it += 2;
-                continue;
-            }
-             
-            tokens.push_back(Token(Token::opIntersect, "&", currentLineNumber));
-            ++it;
-            continue;
+        else if (c == '&') {
+            peek(i+1) == '&' ? emit(Token::opLogicalAnd, i, 2) : emit(Token::opIntersect, i, 1);
         }
 
         // |, ||
-        else if (*it == '|') {
-            if (*(it+1) == '|') {
-                tokens.push_back(Token(Token::opLogicalOr, "||", currentLineNumber));
-                it += 2;
-                continue;
-            }
-
-            tokens.push_back(Token(Token::opUnion, "|", currentLineNumber));
-            ++it;
-            continue;
-        }
-
-        // ^
-        else if (*it == '^') {
-            tokens.push_back(Token(Token::opJoin, "^", currentLineNumber));
-            ++it;
-            continue;
+        else if (c == '|') {
+            peek(i+1) == '|' ? emit(Token::opLogicalOr, i, 2) : emit(Token::opUnion, i, 1);
         }
 
-        // <, <=, <-
-        else if (*it == '<') {
-            if (*(it+1) == '=') {
-                tokens.push_back(Token(Token::opLessThanOrEquals, "<=", currentLineNumber));
-                it += 2;
-                continue;
+        // <, <=, <-, <<
+        else if (c == '<') {
+            if (peek(i+1) == '=') {
+                emit(Token::opLessThanOrEquals, i, 2);
             }
-            else if (*(it+1) == '-') {
-                tokens.push_back(Token(Token::arrowLeft, "<-", currentLineNumber));
-                it += 2;
-                continue;
+            else if (peek(i+1) == '-') {
+                emit(Token::arrowLeft, i, 2);
             }
-
-            tokens.push_back(Token(Token::opLessThan, "<", currentLineNumber));
-            ++it;
-            continue;
-        }
-
-        // >, >=
-        else if (*it == '>') {
-            if (*(it+1) == '=') {
-                tokens.push_back(Token(Token::opGreaterThanOrEquals, ">=", currentLineNumber));
-                it += 2;
-                continue;
+            else if (peek(i+1) == '<') {
+                emit(Token::chevronLeft, i, 2);
             }
-
-            tokens.push_back(Token(Token::opGreaterThan, ">", currentLineNumber));
-            ++it;
-            continue;
-        }
-
-        // ?
-        else if (*it == '?') {
-            tokens.push_back(Token(Token::questionMark, "?", currentLineNumber));
-            ++it;
-            continue;
-        }
-
-        // !, !=
-        else if (*it == '!') {
-            if (*(it+1) == '=') {
-                tokens.push_back(Token(Token::opNotEquals, "!=", currentLineNumber));
-                it += 2;
-                continue;
+            else {
+                emit(Token::opLessThan, i, 1);
             }
-
-            tokens.push_back(Token(Token::exclamationPoint, "!", currentLineNumber));
-            ++it;
-            continue;
         }
 
-        // ,
-        else if (*it == ',') {
-            tokens.push_back(Token(Token::comma, ",", currentLineNumber));
-            ++it;
-            continue;         
-        }
-
-        // (
-        else if (*it == '(') {
-            tokens.push_back(Token(Token::openParen, "(", currentLineNumber));
-            ++it;
-            continue;
+        // >, >=
+        else if (c == '>') {
+            peek(i+1) == '=' ? emit(Token::opGreaterThanOrEquals, i, 2) : emit(Token::opGreaterThan, i, 1);
         }
 
-        // )
-        else if (*it == ')') {
-            tokens.push_back(Token(Token::closeParen, ")", currentLineNumber));
-            ++it;
-            continue;
+        // !, !=
+        else if (c == '!') {
+            peek(i+1) == '=' ? emit(Token::opNotEquals, i, 2) : emit(Token::exclamationPoint, i, 1);
         }
 
         // :, :=
-        else if (*it == ':') {
-            if (*(it+1) == '=') {
-                tokens.push_back(Token(Token::opWalrus, ":=", currentLineNumber));
-                it += 2;
-                continue;
-            }
-
-            tokens.push_back(Token(Token::colon, ":", currentLineNumber));
-            ++it;
-            continue;
-        }
-
-        // ;
-        else if (*it == ';') {
-            tokens.push_back(Token(Token::semicolon, ";", currentLineNumber));
-            ++it;
-            continue;
-        }
-
-        // @
-        else if (*it == '@') {
-            tokens.push_back(Token(Token::at, "@", currentLineNumber));
-            ++it;
-            continue;
+        else if (c == ':') {
+            peek(i+1) == '=' ? emit(Token::opWalrus, i, 2) : emit(Token::colon, i, 1);
         }
 
-        // ~
-        else if (*it == '~') {
-            tokens.push_back(Token(Token::tilde, "~", currentLineNumber));
-            ++it;
-            continue;
-        }
+        // single character tokens
+        else if (c == '.') { emit(Token::dot, i, 1); }
+        else if (c == '+') { emit(Token::opPlus, i, 1); }
+        else if (c == '*') { emit(Token::opMultiply, i, 1); }
+        else if (c == '/') { emit(Token::opDivide, i, 1); }
+        else if (c == '%') { emit(Token::opModulus, i, 1); }
+        else if (c == '^') { emit(Token::opJoin, i, 1); }
+        else if (c == '?') { emit(Token::questionMark, i, 1); }
+        else if (c == ',') { emit(Token::comma, i, 1); }
+        else if (c == '(') { emit(Token::openParen, i, 1); }
+        else if (c == ')') { emit(Token::closeParen, i, 1); }
+        else if (c == ';') { emit(Token::semicolon, i, 1); }
+        else if (c == '@') { emit(Token::at, i, 1); }
+        else if (c == '~') { emit(Token::tilde, i, 1); }
 
         else {
-            std::cout << "Internal lexer error: Invalid character \"" << *it << "\" on line " << currentLineNumber << ". Terminating.\n";
+            std::cout << "Internal lexer error: Invalid character \"" << c << "\" on line " << currentLineNumber << ". Terminating.\n";
             exit(1);
         }
     }
@@ -0,0 +1,527 @@
+// LsmTree.cpp
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "microRDB/LsmTree.hpp"
+
+namespace {
+    void storageError(const std::string& message, const std::string& path) {
+        std::cout << "Storage error. " << message << " \"" << path << "\". Terminating.\n";
+        exit(1);
+    }
+
+    // records per read or write, runs are only ever written front to back
+    constexpr size_t ioRecords = 4096;
+
+    // sequence number then position, ahead of the fields
+    constexpr size_t headerSize = 2 * sizeof(uint64_t);
+
+    // the binary load format's field widths
+    size_t fieldWidth(const Column& column) {
+        switch (column.type) {
+            case Value::intType: return sizeof(int);
+            case Value::floatType: return sizeof(float);
+            case Value::boolType: return 1;
+            case Value::charsType: return column.numChars;
+        }
+        return 0;
+    }
+
+    void writeAll(int fd, const char* data, size_t size, const std::string& path) {
+        size_t done = 0;
+        while (done < size) {
+            ssize_t n = write(fd, data + done, size - done);
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                storageError("Could not write run file", path);
+            }
+            done += n;
+        }
+    }
+
+    void readAt(int fd, char* data, size_t size, size_t offset, const std::string& path) {
+        size_t done = 0;
+        while (done < size) {
+            ssize_t n = pread(fd, data + done, size - done, offset + done);
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                storageError("Could not read run file", path);
+            }
+            done += n;
+        }
+    }
+}
+
+LsmTree::Run::Run(const std::string& path, size_t level, size_t numRecords)
+    : path(path), level(level), numRecords(numRecords), bloom(numRecords) {}
+
+LsmTree::Run::~Run() {
+    if (fd != -1) {
+        close(fd);
+    }
+    unlink(path.c_str());
+}
+
+LsmTree::LsmTree(const std::string& directory, const std::string& name, const std::vector<Column>& columns)
+    : directory(directory), name(name), columns(columns) {
+    if (mkdir(directory.c_str(), 0755) == -1 && errno != EEXIST) {
+        storageError("Could not create directory", directory);
+    }
+    recordSize = headerSize;
+    for (const auto& column : columns) {
+        recordSize += fieldWidth(column);
+    }
+    thread = std::thread(&LsmTree::backgroundLoop, this);
+}
+
+LsmTree::~LsmTree() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    thread.join();
+}
+
+void LsmTree::encode(const Entry& entry, char* record) const {
+    memcpy(record, &entry.sequence, sizeof(entry.sequence));
+    memcpy(record + sizeof(entry.sequence), &entry.position, sizeof(entry.position));
+    char* field = record + headerSize;
+    for (size_t c = 0; c < columns.size(); ++c) {
+        const Value& v = entry.row[c];
+        switch (columns[c].type) {
+            case Value::intType: memcpy(field, &v.intValue, sizeof(v.intValue)); break;
+            case Value::floatType: memcpy(field, &v.floatValue, sizeof(v.floatValue)); break;
+            case Value::boolType: *field = v.boolValue ? 1 : 0; break;
+            case Value::charsType:
+                memset(field, 0, columns[c].numChars);
+                memcpy(field, v.charsValue.data(), std::min(v.charsValue.size(), columns[c].numChars));
+                break;
+        }
+        field += fieldWidth(columns[c]);
+    }
+}
+
+LsmTree::Entry LsmTree::decode(const char* record) const {
+    Entry entry;
+    memcpy(&entry.sequence, record, sizeof(entry.sequence));
+    memcpy(&entry.position, record + sizeof(entry.sequence), sizeof(entry.position));
+    const char* field = record + headerSize;
+    entry.row.reserve(columns.size());
+    for (const auto& column : columns) {
+        switch (column.type) {
+            case Value::intType: {
+                int value;
+                memcpy(&value, field, sizeof(value));
+                entry.row.push_back(Value(value));
+                break;
+            }
+            case Value::floatType: {
+                float value;
+                memcpy(&value, field, sizeof(value));
+                entry.row.push_back(Value(value));
+                break;
+            }
+            case Value::boolType:
+                entry.row.push_back(Value(*field != 0));
+                break;
+            case Value::charsType:
+                entry.row.push_back(Value(std::string(field, strnlen(field, column.numChars))));
+                break;
+        }
+        field += fieldWidth(column);
+    }
+    return entry;
+}
+
+Value LsmTree::keyOf(const char* record) const {
+    const char* field = record + headerSize;
+    switch (columns[0].type) {
+        case Value::intType: {
+            int value;
+            memcpy(&value, field, sizeof(value));
+            return Value(value);
+        }
+        case Value::floatType: {
+            float value;
+            memcpy(&value, field, sizeof(value));
+            return Value(value);
+        }
+        case Value::boolType:
+            return Value(*field != 0);
+        case Value::charsType:
+            return Value(std::string(field, strnlen(field, columns[0].numChars)));
+    }
+    return Value();
+}
+
+template <typename NextRecord>
+std::shared_ptr<const LsmTree::Run> LsmTree::writeRun(size_t level, size_t maxRecords, NextRecord nextRecord) {
+    // run ids are only drawn on the background thread
+    std::string path = directory + "/" + name + "." + std::to_string(nextRunId++) + ".run";
+    auto run = std::make_shared<Run>(path, level, maxRecords);
+    run->fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (run->fd == -1) {
+        storageError("Could not create run file", path);
+    }
+
+    std::vector<char> buffer(ioRecords * recordSize);
+    size_t buffered = 0;
+    size_t numRecords = 0;
+    while (numRecords < maxRecords && nextRecord(buffer.data() + buffered * recordSize)) {
+        Value key = keyOf(buffer.data() + buffered * recordSize);
+        run->bloom.add(key.hash());
+        if (numRecords++ % fenceInterval == 0) {
+            run->fences.push_back(std::move(key));
+        }
+        if (++buffered == ioRecords) {
+            writeAll(run->fd, buffer.data(), buffered * recordSize, path);
+            buffered = 0;
+        }
+    }
+    writeAll(run->fd, buffer.data(), buffered * recordSize, path);
+    run->numRecords = numRecords;
+    return run;
+}
+
+std::shared_ptr<const LsmTree::Run> LsmTree::flush(const std::vector<Entry>& entries) {
+    // entries are in sequence order, so a stable sort by key leaves equal keys in sequence order
+    std::vector<size_t> order(entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return entries[a].row[0] < entries[b].row[0]; });
+
+    size_t next = 0;
+    return writeRun(0, entries.size(), [&](char* record) {
+        encode(entries[order[next++]], record);
+        return true;
+    });
+}
+
+std::shared_ptr<const LsmTree::Run> LsmTree::merge(const std::vector<std::shared_ptr<const Run>>& inputs, const DeletionBitmap& dropped) {
+    // each input is read front to back a buffer at a time
+    struct Cursor {
+        const Run* run;
+        std::vector<char> buffer;
+        size_t begin = 0; // first record in the buffer
+        size_t end = 0;
+        size_t index = 0;
+        Value key;
+        uint64_t sequence = 0;
+    };
+    auto advance = [&](Cursor& cursor) {
+        if (cursor.index == cursor.end && cursor.index < cursor.run->numRecords) {
+            size_t count = std::min(ioRecords, cursor.run->numRecords - cursor.index);
+            readAt(cursor.run->fd, cursor.buffer.data(), count * recordSize, cursor.index * recordSize, cursor.run->path);
+            cursor.begin = cursor.index;
+            cursor.end = cursor.index + count;
+        }
+        if (cursor.index < cursor.run->numRecords) {
+            const char* record = cursor.buffer.data() + (cursor.index - cursor.begin) * recordSize;
+            cursor.key = keyOf(record);
+            memcpy(&cursor.sequence, record, sizeof(cursor.sequence));
+        }
+    };
+
+    std::vector<Cursor> cursors(inputs.size());
+    size_t numRecords = 0;
+    size_t level = 0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        cursors[i].run = inputs[i].get();
+        cursors[i].buffer.resize(ioRecords * recordSize);
+        advance(cursors[i]);
+        numRecords += inputs[i]->numRecords;
+        level = std::max(level, inputs[i]->level);
+    }
+
+    // by key then sequence, there are only fanout inputs to pick from, tombstoned versions are left out
+    return writeRun(level + 1, numRecords, [&](char* record) {
+        while (true) {
+            Cursor* least = nullptr;
+            for (auto& cursor : cursors) {
+                if (cursor.index == cursor.run->numRecords) {
+                    continue;
+                }
+                if (least == nullptr || cursor.key < least->key
+                    || (!(least->key < cursor.key) && cursor.sequence < least->sequence)) {
+                    least = &cursor;
+                }
+            }
+            if (least == nullptr) {
+                return false;
+            }
+            bool live = !dropped.contains(least->sequence);
+            if (live) {
+                memcpy(record, least->buffer.data() + (least->index - least->begin) * recordSize, recordSize);
+            }
+            ++least->index;
+            advance(*least);
+            if (live) {
+                return true;
+            }
+        }
+    });
+}
+
+std::vector<std::shared_ptr<const LsmTree::Run>> LsmTree::fullLevel() const {
+    std::vector<size_t> counts;
+    for (const auto& run : runs) {
+        counts.resize(std::max(counts.size(), run->level + 1), 0);
+        ++counts[run->level];
+    }
+    for (size_t level = 0; level < counts.size(); ++level) {
+        if (counts[level] < fanout) {
+            continue;
+        }
+        std::vector<std::shared_ptr<const Run>> inputs;
+        for (const auto& run : runs) {
+            if (run->level == level && inputs.size() < fanout) {
+                inputs.push_back(run);
+            }
+        }
+        return inputs;
+    }
+    return {};
+}
+
+void LsmTree::backgroundLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return stopping || !immutables.empty() || !fullLevel().empty(); });
+        if (stopping) {
+            return;
+        }
+
+        // flushes come first, appends may be waiting on them
+        if (!immutables.empty()) {
+            auto entries = immutables.front();
+            lock.unlock();
+            auto run = flush(*entries);
+            lock.lock();
+
+            immutables.erase(immutables.begin());
+            runs.push_back(std::move(run));
+            drained.notify_all();
+            continue;
+        }
+
+        // versions tombstoned while the merge runs are dropped by a later one
+        auto inputs = fullLevel();
+        DeletionBitmap dropped = tombstones;
+        lock.unlock();
+        auto merged = merge(inputs, dropped);
+        lock.lock();
+
+        runs.erase(std::remove_if(runs.begin(), runs.end(), [&](const auto& run) {
+            return std::find(inputs.begin(), inputs.end(), run) != inputs.end();
+        }), runs.end());
+        runs.push_back(std::move(merged));
+    }
+}
+
+void LsmTree::add(Entry entry) {
+    // the memtable is only touched by the thread running statements, the background thread sees sealed copies
+    memtable.push_back(std::move(entry));
+    memtableCopy.reset();
+    if (memtable.size() < memtableRows) {
+        return;
+    }
+
+    // writes go no faster than the background thread writes runs
+    std::unique_lock<std::mutex> lock(mutex);
+    drained.wait(lock, [this] { return immutables.size() < maxImmutables; });
+    immutables.push_back(std::make_shared<const std::vector<Entry>>(std::move(memtable)));
+    memtable.clear();
+    wake.notify_all();
+}
+
+void LsmTree::append(std::vector<Row> appended) {
+    for (auto& row : appended) {
+        add({numWrites++, numPositions++, std::move(row)});
+    }
+}
+
+void LsmTree::erase(const std::vector<RowId>& erased) {
+    if (erased.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& id : erased) {
+        tombstones.insert(id.sequence);
+    }
+    tombstonesCopy.reset();
+}
+
+void LsmTree::update(const std::vector<RowId>& replaced, std::vector<Row> updated) {
+    erase(replaced);
+    for (size_t i = 0; i < replaced.size(); ++i) {
+        add({numWrites++, replaced[i].position, std::move(updated[i])});
+    }
+}
+
+std::vector<Row> LsmTree::collect(const std::vector<const std::vector<Entry>*>& memtables,
+                                  const std::vector<std::shared_ptr<const Run>>& stored, const DeletionBitmap& dead,
+                                  uint64_t positions, std::vector<RowId>* ids) const {
+    // a position holds at most one live version, every row goes straight to its place
+    std::vector<Row> placed(positions);
+    std::vector<uint64_t> sequences(positions);
+    std::vector<bool> live(positions, false);
+    size_t numLive = 0;
+    auto place = [&](uint64_t sequence, uint64_t position, Row row) {
+        if (position < positions && !dead.contains(sequence)) {
+            placed[position] = std::move(row);
+            sequences[position] = sequence;
+            live[position] = true;
+            ++numLive;
+        }
+    };
+    for (const auto* entries : memtables) {
+        for (const auto& entry : *entries) {
+            place(entry.sequence, entry.position, entry.row);
+        }
+    }
+    std::vector<char> buffer(ioRecords * recordSize);
+    for (const auto& run : stored) {
+        for (size_t begin = 0; begin < run->numRecords; begin += ioRecords) {
+            size_t count = std::min(ioRecords, run->numRecords - begin);
+            readAt(run->fd, buffer.data(), count * recordSize, begin * recordSize, run->path);
+            for (size_t r = 0; r < count; ++r) {
+                Entry entry = decode(buffer.data() + r * recordSize);
+                place(entry.sequence, entry.position, std::move(entry.row));
+            }
+        }
+    }
+
+    // positions of deleted rows are left empty
+    std::vector<Row> output;
+    output.reserve(numLive);
+    if (ids != nullptr) {
+        ids->clear();
+        ids->reserve(numLive);
+    }
+    for (size_t position = 0; position < positions; ++position) {
+        if (!live[position]) {
+            continue;
+        }
+        output.push_back(std::move(placed[position]));
+        if (ids != nullptr) {
+            ids->push_back({sequences[position], position});
+        }
+    }
+    return output;
+}
+
+std::vector<Row> LsmTree::rows(std::vector<RowId>* ids) {
+    std::vector<const std::vector<Entry>*> memtables = {&memtable};
+    std::vector<std::shared_ptr<const std::vector<Entry>>> sealed;
+    std::vector<std::shared_ptr<const Run>> stored;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sealed = immutables;
+        stored = runs;
+    }
+    for (const auto& entries : sealed) {
+        memtables.push_back(entries.get());
+    }
+    return collect(memtables, stored, tombstones, numPositions, ids);
+}
+
+LsmTree::View LsmTree::view() {
+    if (!memtableCopy) {
+        memtableCopy = std::make_shared<const std::vector<Entry>>(memtable);
+    }
+    if (!tombstonesCopy) {
+        tombstonesCopy = std::make_shared<const DeletionBitmap>(tombstones);
+    }
+
+    View view;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        view.memtables = immutables;
+        view.runs = runs;
+    }
+    view.memtables.push_back(memtableCopy);
+    view.tombstones = tombstonesCopy;
+    view.numPositions = numPositions;
+    return view;
+}
+
+std::vector<Row> LsmTree::rows(const View& view) const {
+    std::vector<const std::vector<Entry>*> memtables;
+    for (const auto& entries : view.memtables) {
+        memtables.push_back(entries.get());
+    }
+    return collect(memtables, view.runs, *view.tombstones, view.numPositions, nullptr);
+}
+
+std::vector<Row> LsmTree::lookup(const Value& key) {
+    std::vector<std::shared_ptr<const std::vector<Entry>>> sealed;
+    std::vector<std::shared_ptr<const Run>> stored;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sealed = immutables;
+        stored = runs;
+    }
+
+    std::vector<Entry> found;
+    for (const auto& entry : memtable) {
+        if (entry.row[0] == key && !tombstones.contains(entry.sequence)) {
+            found.push_back(entry);
+        }
+    }
+    for (const auto& entries : sealed) {
+        for (const auto& entry : *entries) {
+            if (entry.row[0] == key && !tombstones.contains(entry.sequence)) {
+                found.push_back(entry);
+            }
+        }
+    }
+
+    size_t hash = key.hash();
+    std::vector<char> buffer(fenceInterval * recordSize);
+    for (const auto& run : stored) {
+        if (!run->bloom.mayContain(hash)) {
+            continue;
+        }
+
+        // the block before the first fence not below key may hold the first records of key
+        size_t block = std::lower_bound(run->fences.begin(), run->fences.end(), key) - run->fences.begin();
+        bool past = false;
+        for (size_t begin = (block > 0 ? block - 1 : 0) * fenceInterval; begin < run->numRecords && !past; begin += fenceInterval) {
+            size_t count = std::min(fenceInterval, run->numRecords - begin);
+            readAt(run->fd, buffer.data(), count * recordSize, begin * recordSize, run->path);
+            for (size_t r = 0; r < count && !past; ++r) {
+                const char* record = buffer.data() + r * recordSize;
+                Value recordKey = keyOf(record);
+                past = key < recordKey;
+                uint64_t sequence;
+                memcpy(&sequence, record, sizeof(sequence));
+                if (recordKey == key && !tombstones.contains(sequence)) {
+                    found.push_back(decode(record));
+                }
+            }
+        }
+    }
+
+    std::sort(found.begin(), found.end(), [](const Entry& a, const Entry& b) { return a.position < b.position; });
+    std::vector<Row> output;
+    output.reserve(found.size());
+    for (auto& entry : found) {
+        output.push_back(std::move(entry.row));
+    }
+    return output;
+}
+
+size_t LsmTree::numRuns() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return runs.size();
+}
@@ -0,0 +1,47 @@
+// ParallelParser.cpp
+
+#include <algorithm>
+#include "microRDB/Lexer.hpp"
+#include "microRDB/ParallelParser.hpp"
+#include "microRDB/Parser.hpp"
+
+std::unique_ptr<Node::Script> ParallelParser::parse(std::string_view text) {
+    // the prescan is sequential since literals and comments carry state, but it only looks for ; " and #
+    Lexer lexer;
+    std::vector<std::string_view> pieces;
+    std::vector<uint32_t> lineNumbers;
+    uint32_t lineNumber = 1;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = std::min(start + pieceSize, text.size());
+
+        // cut at the first statement end at or past end
+        size_t statementEnd = lexer.findStatementEnd(text, start);
+        while (statementEnd != std::string_view::npos && statementEnd < end) {
+            statementEnd = lexer.findStatementEnd(text, statementEnd);
+        }
+        end = statementEnd == std::string_view::npos ? text.size() : statementEnd;
+
+        pieces.push_back(text.substr(start, end - start));
+        lineNumbers.push_back(lineNumber);
+        lineNumber += std::count(text.begin() + start, text.begin() + end, '\n');
+        start = end;
+    }
+
+    // one piece per morsel
+    // each piece gets its own arena, the script takes ownership of all of them
+    std::vector<std::vector<Node::Ref<Node::Node>>> parsed(pieces.size());
+    std::vector<std::unique_ptr<Arena>> arenas(pieces.size());
+    pool.parallelFor(pieces.size(), 1, [&](size_t m, size_t, size_t) {
+        auto tokens = Lexer().lexViews(pieces[m], lineNumbers[m]);
+        Parser parser(tokens);
+        parsed[m] = parser.parseStatements();
+        arenas[m] = parser.takeArena();
+    });
+
+    std::vector<Node::Ref<Node::Node>> statements;
+    for (auto& piece : parsed) {
+        statements.insert(statements.end(), piece.begin(), piece.end());
+    }
+    return std::make_unique<Node::Script>(statements, arenas);
+}
@@ -1,28 +1,61 @@
 // Parser.cpp
 
+#include <algorithm>
+#include <charconv>
 #include <iostream>
 #include "microRDB/Parser.hpp"
 
+namespace {
+    bool isLiteral(Token::Type type) {
+        return type == Token::intLiteral || type == Token::floatLiteral || type == Token::kwTrue
+            || type == Token::kwFalse || type == Token::charsLiteral;
+    }
+}
+
+Parser::Parser(const std::vector<Token>& tokens)
+    : arena(std::make_unique<Arena>()) {
+    ownedViews.reserve(tokens.size());
+    for (const auto& token : tokens) {
+        ownedViews.push_back(TokenView(token.type, token.value, token.lineNumber));
+    }
+    first = ownedViews.data();
+    last = ownedViews.data() + ownedViews.size();
+}
+
 std::unique_ptr<Node::Script> Parser::parse() {
-    it = tokens.begin();
+    auto statements = parseStatements();
+    std::vector<std::unique_ptr<Arena>> arenas;
+    arenas.push_back(takeArena());
+    return std::make_unique<Node::Script>(statements, arenas);
+}
+
+// SCRIPT - [STATEMENT ;]*
+std::vector<Node::Ref<Node::Node>> Parser::parseStatements() {
+    it = first;
 
-    std::vector<std::unique_ptr<Node::Node>> statements;
-    while (it != tokens.cend()) {
+    std::vector<Node::Ref<Node::Node>> statements;
+    while (it != last) {
         // bounds check
-        if (it+1 == tokens.cend()) {
+        if (it+1 == last) {
             std::cout << "Parser error. Unexpected end of input on line " << it->lineNumber << ".\n";
             exit(1);
         }
 
-        if (*(it+1) == Token::opAssign) {
+        if (*(it+1) == Token::opAssign || *(it+1) == Token::opEquals) {
             statements.push_back(parseCreate());
         }
         else if (*(it+1) == Token::arrowLeft) {
             statements.push_back(parseInsert());
         }
+        else if (*(it+1) == Token::chevronLeft) {
+            statements.push_back(parseLoad());
+        }
         else if (*(it+1) == Token::tilde) {
             statements.push_back(parseDrop());
         }
+        else if (*(it+1) == Token::at) {
+            statements.push_back(parseAnalyze());
+        }
         else if (*(it+1) == Token::exclamationPoint) {
             statements.push_back(parseDelete());
         }
@@ -37,14 +70,22 @@ std::unique_ptr<Node::Script> Parser::parse() {
         discard(Token::semicolon);
     }
 
-    return std::make_unique<Node::Script>(statements);
+    return statements;
 }
 
 // CREATE - TABLE_NAME = TYPE_ID_LIST | SELECT_EXPR
-std::unique_ptr<Node::Create> Parser::parseCreate() {
-    std::string name = consume(Token::identifier);
+//        | TABLE_NAME == SELECT_EXPR
+Node::Create* Parser::parseCreate() {
+    std::string_view name = consume(Token::identifier);
+
+    // maintained from its definition
+    if (*it == Token::opEquals) {
+        discard(Token::opEquals);
+        return make<Node::Create>(name, parseSelectExpression(), true);
+    }
+
     discard(Token::opAssign);
-    std::unique_ptr<Node::Node> RHS;
+    Node::Node* RHS;
     // @TODO: bounds check with a peek method
     if (*(it+1) == Token::colon) {
         RHS = parseNameTypeList();
@@ -53,34 +94,34 @@ std::unique_ptr<Node::Create> Parser::parseCreate() {
         RHS = parseSelectExpression();
     }
 
-    return std::make_unique<Node::Create>(name, std::move(RHS));
+    return make<Node::Create>(name, RHS);
 }
 
 // NAME_TYPE_LIST - NAME_TYPE_PAIR [, NAME_TYPE_PAIR]*
-std::unique_ptr<Node::NameTypeList> Parser::parseNameTypeList() {
-    std::vector<std::unique_ptr<Node::Node>> pairs;
-    pairs.push_back(parseNameTypePair());
+Node::NameTypeList* Parser::parseNameTypeList() {
+    size_t start = scratch.size();
+    scratch.push_back(parseNameTypePair());
     while (*it == Token::comma) {
         discard(Token::comma);
-        pairs.push_back(parseNameTypePair());
+        scratch.push_back(parseNameTypePair());
     }
 
-    return std::make_unique<Node::NameTypeList>(pairs);
+    return make<Node::NameTypeList>(makeList<Node::Node>(start));
 }
 
 // NAME_TYPE_PAIR - IDENTIFIER : [kwInt | kwFloat | kwBool | [kwChars INTEGER]]
-std::unique_ptr<Node::NameTypePair> Parser::parseNameTypePair() {
-    std::string name = consume(Token::identifier);
+Node::NameTypePair* Parser::parseNameTypePair() {
+    std::string_view name = consume(Token::identifier);
     discard(Token::colon);
-    std::string type;
+    std::string_view type;
     if (*it == Token::kwInt || *it == Token::kwFloat || *it == Token::kwBool) {
         type = consume(*it);
     }
     else if (*it == Token::kwChars) {
         type = consume(Token::kwChars);
-        std::string numChars = consume(Token::intLiteral);
+        std::string_view numChars = consume(Token::intLiteral);
 
-        return std::make_unique<Node::NameTypePair>(name, type, numChars);
+        return make<Node::NameTypePair>(name, type, numChars);
     }
     else {
         std::cout << "Parser error. Expected a type name on line " << it->lineNumber <<  ". Got "
@@ -89,106 +130,150 @@ std::unique_ptr<Node::NameTypePair> Parser::parseNameTypePair() {
         exit(1);
     }
     
-    return std::make_unique<Node::NameTypePair>(name, type);
+    return make<Node::NameTypePair>(name, type);
 }
 
 // DROP - IDENTIFIER ~
-std::unique_ptr<Node::Drop> Parser::parseDrop() {
-    std::string name = consume(Token::identifier);
+Node::Drop* Parser::parseDrop() {
+    std::string_view name = consume(Token::identifier);
     discard(Token::tilde);
-    return std::make_unique<Node::Drop>(name);
+    return make<Node::Drop>(name);
+}
+
+// ANALYZE - IDENTIFIER @
+Node::Analyze* Parser::parseAnalyze() {
+    std::string_view name = consume(Token::identifier);
+    discard(Token::at);
+    return make<Node::Analyze>(name);
 }
 
 // DELETE - IDENTIFIER ! FILTER [FILTER]*
-std::unique_ptr<Node::Delete> Parser::parseDelete() {
-    std::string name = consume(Token::identifier);
+Node::Delete* Parser::parseDelete() {
+    std::string_view name = consume(Token::identifier);
     discard(Token::exclamationPoint);
-    std::vector<std::unique_ptr<Node::Filter>> filters;
-    filters.push_back(parseFilter());
+    size_t start = scratch.size();
+    scratch.push_back(parseFilter());
     while (*it == Token::questionMark) {
-        filters.push_back(parseFilter());
+        scratch.push_back(parseFilter());
     }
+    auto filters = makeList<Node::Filter>(start);
 
-    return std::make_unique<Node::Delete>(name, filters);
+    return make<Node::Delete>(name, filters);
 }
 
 // FILTER - ? OR_EXPR
-std::unique_ptr<Node::Filter> Parser::parseFilter() {
+Node::Filter* Parser::parseFilter() {
     discard(Token::questionMark);
     auto expr = parseOrExpression();
-    return std::make_unique<Node::Filter>(std::move(expr));
+    return make<Node::Filter>(expr);
 }
 
 // UPDATE - IDENTIFIER := ASSIGN_LIST FILTER [FILTER]*
-std::unique_ptr<Node::Update> Parser::parseUpdate() {
-    std::string name = consume(Token::identifier);
+Node::Update* Parser::parseUpdate() {
+    std::string_view name = consume(Token::identifier);
     discard(Token::opWalrus);
     auto assignList = parseAssignList();
-    std::vector<std::unique_ptr<Node::Filter>> filters;
-    filters.push_back(parseFilter());
+    size_t start = scratch.size();
+    scratch.push_back(parseFilter());
     while (*it == Token::questionMark) {
-        filters.push_back(parseFilter());
+        scratch.push_back(parseFilter());
     }
+    auto filters = makeList<Node::Filter>(start);
 
-    return std::make_unique<Node::Update>(name, std::move(assignList), filters);
+    return make<Node::Update>(name, assignList, filters);
 }
 
 // ASSIGN_LIST - ASSIGN [, ASSIGN]*
-std::unique_ptr<Node::AssignList> Parser::parseAssignList() {
-    std::vector<std::unique_ptr<Node::Node>> assigns;
-    assigns.push_back(parseAssign());
+Node::AssignList* Parser::parseAssignList() {
+    size_t start = scratch.size();
+    scratch.push_back(parseAssign());
     while (*it == Token::comma) {
         discard(Token::comma);
-        assigns.push_back(parseAssign());
+        scratch.push_back(parseAssign());
     }
     
-    return std::make_unique<Node::AssignList>(assigns);
+    return make<Node::AssignList>(makeList<Node::Node>(start));
 }
 
 // ASSIGN - IDENTIFIER ( OR_EXPR )
-std::unique_ptr<Node::Assign> Parser::parseAssign() {
-    std::string name = consume(Token::identifier);
+Node::Assign* Parser::parseAssign() {
+    std::string_view name = consume(Token::identifier);
     discard(Token::openParen);
     auto expr = parseOrExpression();
     discard(Token::closeParen);
 
-    return std::make_unique<Node::Assign>(name, std::move(expr));
+    return make<Node::Assign>(name, expr);
 }
 
 // INSERT - TABLE_NAME <- EXPRESSION_LIST [<- EXPRESSION_LIST]*
-std::unique_ptr<Node::Insert> Parser::parseInsert() {
-    std::vector<std::unique_ptr<Node::Node>> expressionLists;
-    std::string name = consume(Token::identifier);
+Node::Node* Parser::parseInsert() {
+    size_t start = scratch.size();
+    std::string_view name = consume(Token::identifier);
     discard(Token::arrowLeft);
-    expressionLists.push_back(parseExpressionList());
+
+    // literal rows skip building an expression tree per value
+    size_t numRows = 0;
+    size_t numColumns = 0;
+    if (literalRows(numRows, numColumns)) {
+        return parseBulkInsert(name, numRows, numColumns);
+    }
+
+    scratch.push_back(parseExpressionList());
     while (*it == Token::arrowLeft) {
         discard (Token::arrowLeft);
-        expressionLists.push_back(parseExpressionList());
+        scratch.push_back(parseExpressionList());
+    }
+
+    return make<Node::Insert>(name, makeList<Node::Node>(start));
+}
+
+// same rows as parseInsert, every value a literal and every row the same length
+Node::BulkInsert* Parser::parseBulkInsert(std::string_view name, size_t numRows, size_t numColumns) {
+    auto* literals = arena->makeArray<Node::Literal>(numRows * numColumns);
+    for (size_t r = 0; r < numRows; ++r) {
+        if (r > 0) {
+            discard(Token::arrowLeft);
+        }
+        for (size_t c = 0; c < numColumns; ++c) {
+            if (c > 0) {
+                discard(Token::comma);
+            }
+            new (&literals[r * numColumns + c]) Node::Literal(parseLiteral());
+        }
     }
 
-    return std::make_unique<Node::Insert>(name, expressionLists);
+    return make<Node::BulkInsert>(name, numRows, numColumns, literals);
 }
 
 // EXPRESSION_LIST - OR_EXPR [, OR_EXPR]*
-std::unique_ptr<Node::ExpressionList> Parser::parseExpressionList() {
-    std::vector<std::unique_ptr<Node::Node>> expressions;
-    expressions.push_back(parseOrExpression());
+Node::ExpressionList* Parser::parseExpressionList() {
+    size_t start = scratch.size();
+    scratch.push_back(parseOrExpression());
     while (*it == Token::comma) {
         discard(Token::comma);
-        expressions.push_back(parseOrExpression());
+        scratch.push_back(parseOrExpression());
     }
 
-    return std::make_unique<Node::ExpressionList>(expressions);
+    return make<Node::ExpressionList>(makeList<Node::Node>(start));
+}
+
+// LOAD - TABLE_NAME << CHARS_LITERAL
+Node::Load* Parser::parseLoad() {
+    std::string_view name = consume(Token::identifier);
+    discard(Token::chevronLeft);
+    std::string_view path = consume(Token::charsLiteral);
+
+    return make<Node::Load>(name, arena->copy(path));
 }
 
 // OR_EXPR         - AND_EXPR
 //                 | OR_EXPR || AND_EXPR
-std::unique_ptr<Node::Node> Parser::parseOrExpression() {
+Node::Node* Parser::parseOrExpression() {
     auto LHS = parseAndExpression();
     while (*it == Token::opLogicalOr) {
         discard(Token::opLogicalOr);
         auto RHS = parseAndExpression();
-        LHS = std::make_unique<Node::OrExpression>(std::move(LHS), std::move(RHS));
+        LHS = make<Node::OrExpression>(LHS, RHS);
     }
 
     return LHS;
@@ -196,12 +281,12 @@ std::unique_ptr<Node::Node> Parser::parseOrExpression() {
 
 // AND_EXPR        - EQUALITY_EXPR
 //                 | AND_EXPR && EQUALITY_EXPR
-std::unique_ptr<Node::Node> Parser::parseAndExpression() {
+Node::Node* Parser::parseAndExpression() {
     auto LHS = parseEqualityExpression();
     while (*it == Token::opLogicalAnd) {
         discard(Token::opLogicalAnd);
         auto RHS = parseEqualityExpression();
-        LHS = std::make_unique<Node::AndExpression>(std::move(LHS), std::move(RHS));
+        LHS = make<Node::AndExpression>(LHS, RHS);
     }
 
     return LHS;
@@ -210,20 +295,20 @@ std::unique_ptr<Node::Node> Parser::parseAndExpression() {
 // EQUALITY_EXPR   - RELATIONAL_EXPR
 //                 | EQUALITY_EXPR == RELATIONAL_EXPR
 //                 | EQUALITY_EXPR != RELATIONAL_EXPR
-std::unique_ptr<Node::Node> Parser::parseEqualityExpression() {
+Node::Node* Parser::parseEqualityExpression() {
     auto LHS = parseRelationalExpression();
     while (true) {
         if (*it == Token::opEquals) {
-            std::string op = "==";
+            Node::Operator op = Node::opEquals;
             discard(Token::opEquals);
             auto RHS = parseRelationalExpression();
-            LHS = std::make_unique<Node::EqualityExpression>(std::move(LHS), std::move(RHS), op);
+            LHS = make<Node::EqualityExpression>(LHS, RHS, op);
         }
         else if (*it == Token::opNotEquals) {
-            std::string op = "!=";
+            Node::Operator op = Node::opNotEquals;
             discard(Token::opNotEquals);
             auto RHS = parseRelationalExpression();
-            LHS = std::make_unique<Node::EqualityExpression>(std::move(LHS), std::move(RHS), op);
+            LHS = make<Node::EqualityExpression>(LHS, RHS, op);
         }
         else {
             break;
@@ -238,32 +323,32 @@ std::unique_ptr<Node::Node> Parser::parseEqualityExpression() {
 //                 | RELATIONAL_EXPR > ADDITIVE_EXPR
 //                 | RELATIONAL_EXPR <= ADDITIVE_EXPR
 //                 | RELATIONAL_EXPR >= ADDITIVE_EXPR
-std::unique_ptr<Node::Node> Parser::parseRelationalExpression() {
+Node::Node* Parser::parseRelationalExpression() {
     auto LHS = parseAdditiveExpression();
     while (true) {
         if (*it == Token::opLessThan) {
-            std::string op = "<";
+            Node::Operator op = Node::opLessThan;
             discard(Token::opLessThan);
             auto RHS = parseAdditiveExpression();
-            LHS = std::make_unique<Node::RelationalExpression>(std::move(LHS), std::move(RHS), op);
+            LHS = make<Node::RelationalExpression>(LHS, RHS, op);
         }
         else if (*it == Token::opGreaterThan) {
-            std::string op = ">";
+            Node::Operator op = Node::opGreaterThan;
             discard(Token::opGreaterThan);
             auto RHS = parseAdditiveExpression();
-            LHS = std::make_unique<Node::RelationalExpression>(std::move(LHS), std::move(RHS), op);
+            LHS = make<Node::RelationalExpression>(LHS, RHS, op);
         }
         else if (*it == Token::opLessThanOrEquals) {
-            std::string op = "<=";
+            Node::Operator op = Node::opLessThanOrEquals;
             discard(Token::opLessThanOrEquals);
             auto RHS = parseAdditiveExpression();
-            LHS = std::make_unique<Node::RelationalExpression>(std::move(LHS), std::move(RHS), op);
+            LHS = make<Node::RelationalExpression>(LHS, RHS, op);
         }
         else if (*it == Token::opGreaterThanOrEquals) {
-            std::string op = ">=";
+            Node::Operator op = Node::opGreaterThanOrEquals;
             discard(Token::opGreaterThanOrEquals);
             auto RHS = parseAdditiveExpression();
-            LHS = std::make_unique<Node::RelationalExpression>(std::move(LHS), std::move(RHS), op);
+            LHS = make<Node::RelationalExpression>(LHS, RHS, op);
         }
         else {
             break;
@@ -276,21 +361,21 @@ std::unique_ptr<Node::Node> Parser::parseRelationalExpression() {
 // ADDITIVE_EXPR   - MULT_EXPR
 //                 | ADDITIVE_EXPR + MULT_EXPR
 //                 | ADDITIVE_EXPR - MULT_EXPR  
-std::unique_ptr<Node::Node> Parser::parseAdditiveExpression() {
+Node::Node* Parser::parseAdditiveExpression() {
     auto LHS = parseMultiplicativeExpression();
     while (true) {
-        std::string op;
+        Node::Operator op;
         if (*it == Token::opPlus) {
-            op = "+";
+            op = Node::opPlus;
             discard(Token::opPlus);
             auto RHS = parseMultiplicativeExpression();
-            LHS = std::make_unique<Node::AdditiveExpression>(std::move(LHS), std::move(RHS), op);
+            LHS = make<Node::AdditiveExpression>(LHS, RHS, op);
         }
         else if (*it == Token::opMinus) {
-            op = "-";
+            op = Node::opMinus;
             discard(Token::opMinus);
             auto RHS = parseMultiplicativeExpression();
-            LHS = std::make_unique<Node::AdditiveExpression>(std::move(LHS), std::move(RHS), op);
+            LHS = make<Node::AdditiveExpression>(LHS, RHS, op);
         }
         else {
             break;
@@ -304,27 +389,27 @@ std::unique_ptr<Node::Node> Parser::parseAdditiveExpression() {
 //                 | MULT_EXPR * PRIMARY
 //                 | MULT_EXPR / PRIMARY
 //                 | MULT_EXPR % PRIMARY
-std::unique_ptr<Node::Node> Parser::parseMultiplicativeExpression() {
+Node::Node* Parser::parseMultiplicativeExpression() {
     auto LHS = parsePrimary();
     while (true) {
-        std::string op;
+        Node::Operator op;
         if (*it == Token::opMultiply) {
-            op = "*";
+            op = Node::opMultiply;
             discard(Token::opMultiply);
             auto RHS = parsePrimary();
-            LHS = std::make_unique<Node::MultiplicativeExpression>(std::move(LHS), std::move(RHS), op);
+            LHS = make<Node::MultiplicativeExpression>(LHS, RHS, op);
         }
         else if (*it == Token::opDivide) {
-            op = "/";
+            op = Node::opDivide;
             discard(Token::opDivide);
             auto RHS = parsePrimary();
-            LHS = std::make_unique<Node::MultiplicativeExpression>(std::move(LHS), std::move(RHS), op);
+            LHS = make<Node::MultiplicativeExpression>(LHS, RHS, op);
         }
         else if (*it == Token::opModulus) {
-            op = "%";
+            op = Node::opModulus;
             discard(Token::opModulus);
             auto RHS = parsePrimary();
-            LHS = std::make_unique<Node::MultiplicativeExpression>(std::move(LHS), std::move(RHS), op);
+            LHS = make<Node::MultiplicativeExpression>(LHS, RHS, op);
         }
         else {
             break;
@@ -341,38 +426,24 @@ std::unique_ptr<Node::Node> Parser::parseMultiplicativeExpression() {
 //                 | kwTrue
 //                 | kwFalse
 //                 | CHARS_LITERAL
-std::unique_ptr<Node::Node> Parser::parsePrimary() {
+//                 | PARAMETER
+Node::Node* Parser::parsePrimary() {
     if (*it == Token::identifier) {
-        std::string name = consume(Token::identifier);
+        std::string_view name = consume(Token::identifier);
         
-        return std::make_unique<Node::Identifier>(name);
-    }
-    else if (*it == Token::intLiteral) {
-        std::string value = consume(Token::intLiteral);
-        int intValue = std::stoi(value);
-        
-        return std::make_unique<Node::IntLiteral>(intValue);
-    }
-    else if (*it == Token::floatLiteral) {
-        std::string value = consume(Token::floatLiteral);
-        float floatValue = std::stod(value);
-
-        return std::make_unique<Node::FloatLiteral>(floatValue);
-    }
-    else if (*it == Token::kwTrue) {
-        consume(Token::kwTrue);
-
-        return std::make_unique<Node::BoolLiteral>(true);
-    }
-    else if (*it == Token::kwFalse) {
-        consume(Token::kwFalse);
-
-        return std::make_unique<Node::BoolLiteral>(false);
+        return make<Node::Identifier>(name);
+    }
+    else if (isLiteral(*it)) {
+        Node::Literal literal = parseLiteral();
+        switch (literal.type) {
+            case Node::Literal::intType: return make<Node::IntLiteral>(literal.intValue);
+            case Node::Literal::floatType: return make<Node::FloatLiteral>(literal.floatValue);
+            case Node::Literal::boolType: return make<Node::BoolLiteral>(literal.boolValue);
+            case Node::Literal::charsType: return make<Node::CharsLiteral>(literal.charsValue);
+        }
     }
-    else if (*it == Token::charsLiteral) {
-        std::string value = consume(Token::charsLiteral);
-
-        return std::make_unique<Node::CharsLiteral>(value);
+    else if (*it == Token::sigil) {
+        return parseParameter();
     }
     else if (*it == Token::openParen) {
         discard(Token::openParen);
@@ -387,14 +458,61 @@ std::unique_ptr<Node::Node> Parser::parsePrimary() {
     exit(1);
 }
 
+// PARAMETER - $ INT_LITERAL, lexed as one sigil token
+Node::Parameter* Parser::parseParameter() {
+    unsigned lineNumber = it->lineNumber;
+    std::string_view value = consume(Token::sigil);
+    int index = 0;
+    auto result = std::from_chars(value.data() + 1, value.data() + value.size(), index);
+    if (result.ec != std::errc() || index < 1) {
+        std::cout << "Parser error on line " << lineNumber << ". Parameters are numbered from $1, got "
+                  << value << ". Terminating.\n";
+        exit(1);
+    }
+    maxParameter = std::max(maxParameter, index);
+
+    return make<Node::Parameter>(index);
+}
+
+// INT_LITERAL | FLOAT_LITERAL | kwTrue | kwFalse | CHARS_LITERAL
+// numbers are converted with from_chars, chars are copied into the arena
+Node::Literal Parser::parseLiteral() {
+    Node::Literal literal;
+    literal.intValue = 0;
+    if (*it == Token::intLiteral) {
+        std::string_view value = consume(Token::intLiteral);
+        literal.type = Node::Literal::intType;
+        std::from_chars(value.data(), value.data() + value.size(), literal.intValue);
+    }
+    else if (*it == Token::floatLiteral) {
+        std::string_view value = consume(Token::floatLiteral);
+        double doubleValue = 0.0;
+        std::from_chars(value.data(), value.data() + value.size(), doubleValue);
+        literal.type = Node::Literal::floatType;
+        literal.floatValue = doubleValue;
+    }
+    else if (*it == Token::kwTrue || *it == Token::kwFalse) {
+        literal.type = Node::Literal::boolType;
+        literal.boolValue = *it == Token::kwTrue;
+        ++it;
+    }
+    else {
+        std::string_view value = consume(Token::charsLiteral);
+        literal.type = Node::Literal::charsType;
+        literal.charsValue = arena->copy(value);
+    }
+
+    return literal;
+}
+
 // SELECT_EXPR     - PROJECT_EXPR
 //                 | SELECT_EXPR ? OR_EXPR
-std::unique_ptr<Node::Node> Parser::parseSelectExpression() {
+Node::Node* Parser::parseSelectExpression() {
     auto LHS = parseProjectExpression();
     while (*it == Token::questionMark) {
         discard(Token::questionMark);
         auto RHS = parseOrExpression();
-        LHS = std::make_unique<Node::SelectExpression>(std::move(LHS), std::move(RHS));
+        LHS = make<Node::SelectExpression>(LHS, RHS);
     }
 
     return LHS;
@@ -402,37 +520,37 @@ std::unique_ptr<Node::Node> Parser::parseSelectExpression() {
 
 // PROJECT_EXPR    - UNION_EXPR
 //                 | PROJECT_EXPR -> COLUMN_LIST
-std::unique_ptr<Node::Node> Parser::parseProjectExpression() {
+Node::Node* Parser::parseProjectExpression() {
     auto LHS = parseUnionExpression();
     while (*it == Token::arrowRight) {
         discard(Token::arrowRight);
         auto RHS = parseColumnList();
-        LHS = std::make_unique<Node::ProjectExpression>(std::move(LHS), std::move(RHS));
+        LHS = make<Node::ProjectExpression>(LHS, RHS);
     }
 
     return LHS;
 }
 
 // COLUMN_LIST     - IDENTIFIER [, IDENTIFIER]*
-std::unique_ptr<Node::Node> Parser::parseColumnList() {
-    std::vector<std::unique_ptr<Node::Identifier>> columns;
-    columns.push_back(std::make_unique<Node::Identifier>(consume(Token::identifier)));
+Node::Node* Parser::parseColumnList() {
+    size_t start = scratch.size();
+    scratch.push_back(make<Node::Identifier>(consume(Token::identifier)));
     while (*it == Token::comma) {
         discard(Token::comma);
-        columns.push_back(std::make_unique<Node::Identifier>(consume(Token::identifier)));
+        scratch.push_back(make<Node::Identifier>(consume(Token::identifier)));
     }
 
-    return std::make_unique<Node::ColumnList>(columns);
+    return make<Node::ColumnList>(makeList<Node::Identifier>(start));
 }
 
 // UNION_EXPR      - DIFF_EXPR
 //                 | UNION_EXPR | DIFF_EXPR
-std::unique_ptr<Node::Node> Parser::parseUnionExpression() {
+Node::Node* Parser::parseUnionExpression() {
     auto LHS = parseDifferenceExpression();
     while (*it == Token::opUnion) {
         discard(Token::opUnion);
         auto RHS = parseDifferenceExpression();
-        LHS = std::make_unique<Node::UnionExpression>(std::move(LHS), std::move(RHS));
+        LHS = make<Node::UnionExpression>(LHS, RHS);
     }
 
     return LHS;
@@ -440,12 +558,12 @@ std::unique_ptr<Node::Node> Parser::parseUnionExpression() {
 
 // DIFF_EXPR       - INTERSECT_EXPR
 //                 | DIFF_EXPR - INTERSECT_EXPR
-std::unique_ptr<Node::Node> Parser::parseDifferenceExpression() {
+Node::Node* Parser::parseDifferenceExpression() {
     auto LHS = parseIntersectExpression();
     while (*it == Token::opMinus) {
         discard(Token::opMinus);
         auto RHS = parseIntersectExpression();
-        LHS = std::make_unique<Node::DifferenceExpression>(std::move(LHS), std::move(RHS));
+        LHS = make<Node::DifferenceExpression>(LHS, RHS);
     }
 
     return LHS;
@@ -453,12 +571,12 @@ std::unique_ptr<Node::Node> Parser::parseDifferenceExpression() {
 
 // INTERSECT_EXPR  - JOIN_EXPR
 //                 | INTERSECT_EXPR & JOIN_EXPR
-std::unique_ptr<Node::Node> Parser::parseIntersectExpression() {
+Node::Node* Parser::parseIntersectExpression() {
     auto LHS = parseJoinExpression();
     while (*it == Token::opIntersect) {
         discard(Token::opIntersect);
         auto RHS = parseJoinExpression();
-        LHS = std::make_unique<Node::IntersectExpression>(std::move(LHS), std::move(RHS));
+        LHS = make<Node::IntersectExpression>(LHS, RHS);
     }
 
     return LHS;
@@ -466,12 +584,12 @@ std::unique_ptr<Node::Node> Parser::parseIntersectExpression() {
 
 // JOIN_EXPR       - TABLE_PRIMARY
 //                 | JOIN_EXPR ^ TABLE_PRIMARY
-std::unique_ptr<Node::Node> Parser::parseJoinExpression() {
+Node::Node* Parser::parseJoinExpression() {
     auto LHS = parseTablePrimary();
     while (*it == Token::opJoin) {
         discard(Token::opJoin);
         auto RHS = parseTablePrimary();
-        LHS = std::make_unique<Node::JoinExpression>(std::move(LHS), std::move(RHS));
+        LHS = make<Node::JoinExpression>(LHS, RHS);
     }
 
     return LHS;
@@ -479,7 +597,7 @@ std::unique_ptr<Node::Node> Parser::parseJoinExpression() {
 
 // TABLE_PRIMARY   - ( SELECT_EXPR ) 
 //                 | TABLE_NAME
-std::unique_ptr<Node::Node> Parser::parseTablePrimary() {
+Node::Node* Parser::parseTablePrimary() {
     if (*it == Token::openParen) {
         discard(Token::openParen);
         auto expr = parseSelectExpression();
@@ -487,13 +605,43 @@ std::unique_ptr<Node::Node> Parser::parseTablePrimary() {
         return expr;
     }
 
-    std::string name = consume(Token::identifier);
-    return std::make_unique<Node::Identifier>(name);
+    std::string_view name = consume(Token::identifier);
+    return make<Node::Identifier>(name);
+}
+
+// literalRows scans ahead without consuming, stopping at the statement's semicolon
+bool Parser::literalRows(size_t& numRows, size_t& numColumns) const {
+    size_t columns = 0;
+    for (const TokenView* t = it; t != last; ++t) {
+        if (!isLiteral(*t) || ++t == last) {
+            return false;
+        }
+        ++columns;
+        if (*t == Token::comma) {
+            continue;
+        }
+
+        // end of a row
+        if (numRows > 0 && columns != numColumns) {
+            return false;
+        }
+        numColumns = columns;
+        columns = 0;
+        ++numRows;
+        if (*t == Token::semicolon) {
+            return true;
+        }
+        if (*t != Token::arrowLeft) {
+            return false;
+        }
+    }
+
+    return false;
 }
 
 // discard
 void Parser::discard(Token::Type expectedType) {
-    if (it == tokens.cend()) {
+    if (it == last) {
         // throw unexpected end of input
         std::cout << "Unexpected end of input.\n";
         exit(1);
@@ -509,8 +657,8 @@ void Parser::discard(Token::Type expectedType) {
 }
 
 // consume
-std::string Parser::consume(Token::Type expectedType) {
-    if (it == tokens.cend()) {
+std::string_view Parser::consume(Token::Type expectedType) {
+    if (it == last) {
         std::cout << "Unexpected end of input.\n";
         exit(1);
     }
@@ -0,0 +1,109 @@
+// Pipeline.cpp
+
+#include <iostream>
+#include "microRDB/Pipeline.hpp"
+
+namespace {
+    void executionError(const std::string& message) {
+        std::cout << "Execution error. " << message << " Terminating.\n";
+        exit(1);
+    }
+}
+
+void Pipeline::scan(const Table* table, const std::string& name) {
+    source = table;
+    sourceName = name;
+    schema = Table();
+    schema.columns = table->columns;
+}
+
+void Pipeline::scan(Table table, const std::string& name) {
+    ownedTables.push_back(std::make_unique<Table>(std::move(table)));
+    scan(ownedTables.back().get(), name);
+}
+
+void Pipeline::addFilter(const Node::Node* predicate) {
+    PipelineStep step(PipelineStep::filterStep, schema);
+    step.predicate = predicate;
+    steps.push_back(std::move(step));
+}
+
+void Pipeline::addProject(const std::vector<std::string>& columnNames) {
+    PipelineStep step(PipelineStep::projectStep, schema);
+    Table projected;
+    for (const auto& name : columnNames) {
+        int index = schema.columnIndex(name);
+        if (index == -1) {
+            executionError("Unknown column \"" + name + "\" in projection.");
+        }
+        step.indices.push_back(index);
+        projected.columns.push_back(schema.columns[index]);
+    }
+
+    steps.push_back(std::move(step));
+    schema = std::move(projected);
+}
+
+void Pipeline::addProbe(Table build) {
+    auto hashTable = std::make_unique<JoinHashTable>();
+    PipelineStep step(PipelineStep::probeStep, schema);
+
+    // natural join on columns with the same name, cross product if there are none
+    std::vector<size_t> buildKeys;
+    hashTable->buildIsKey.assign(build.columns.size(), false);
+    for (size_t b = 0; b < build.columns.size(); ++b) {
+        int p = schema.columnIndex(build.columns[b].name);
+        if (p == -1) {
+            continue;
+        }
+        if (schema.columns[p].type != build.columns[b].type) {
+            executionError("Join column \"" + build.columns[b].name + "\" has mismatched types.");
+        }
+        buildKeys.push_back(b);
+        step.indices.push_back(p);
+        hashTable->buildIsKey[b] = true;
+    }
+
+    for (size_t i = 0; i < build.rows.size(); ++i) {
+        Row key;
+        key.reserve(buildKeys.size());
+        for (auto k : buildKeys) {
+            key.push_back(build.rows[i][k]);
+        }
+        hashTable->buckets[std::move(key)].push_back(i);
+    }
+
+    // probe columns followed by the build side's non-key columns
+    for (size_t b = 0; b < build.columns.size(); ++b) {
+        if (!hashTable->buildIsKey[b]) {
+            schema.columns.push_back(build.columns[b]);
+        }
+    }
+
+    hashTable->build = std::move(build);
+    step.hashTable = hashTable.get();
+    hashTables.push_back(std::move(hashTable));
+    steps.push_back(std::move(step));
+}
+
+void Pipeline::addRuntimeFilter(RuntimeFilter* filter) {
+    PipelineStep step(PipelineStep::runtimeFilterStep, schema);
+    for (const auto& key : filter->keys) {
+        step.indices.push_back(schema.columnIndex(key));
+    }
+    step.filter = filter;
+    steps.push_back(std::move(step));
+}
+
+std::string Pipeline::toString() const {
+    std::string description = "scan " + sourceName;
+    for (const auto& step : steps) {
+        switch (step.kind) {
+            case PipelineStep::filterStep: description += " -> filter"; break;
+            case PipelineStep::projectStep: description += " -> project"; break;
+            case PipelineStep::probeStep: description += " -> probe"; break;
+            case PipelineStep::runtimeFilterStep: description += " -> runtime filter"; break;
+        }
+    }
+    return description + " -> materialize";
+}
@@ -0,0 +1,231 @@
+// QueryHasher.cpp
+
+#include <algorithm>
+#include <functional>
+#include "microRDB/QueryHasher.hpp"
+
+namespace {
+    // one tag per kind of node, so differently shaped queries do not collide on equal children
+    enum Tag : uint64_t {
+        tableTag = 1,
+        columnTag,
+        intTag,
+        floatTag,
+        boolTag,
+        charsTag,
+        orTag,
+        andTag,
+        equalityTag,
+        relationalTag,
+        additiveTag,
+        multiplicativeTag,
+        selectTag,
+        projectTag,
+        columnListTag,
+        unionTag,
+        differenceTag,
+        intersectTag,
+        joinTag,
+    };
+
+    uint64_t combine(uint64_t seed, uint64_t v) {
+        return seed ^ (v + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+    }
+
+    uint64_t hashName(const std::string& name) {
+        return std::hash<std::string>()(name);
+    }
+
+    // literals of each type are their own kind of node, a parameter hashes as the literal of its value
+    uint64_t hashLiteral(const Value& v) {
+        static const uint64_t tags[] = {intTag, floatTag, boolTag, charsTag};
+        return combine(tags[v.type], v.hash());
+    }
+}
+
+uint64_t QueryHasher::hashQuery(const Node::Node* query) {
+    tables.clear();
+    hashingScalar = false;
+    return hashOf(query);
+}
+
+uint64_t QueryHasher::hashOf(const Node::Node* n) {
+    n->accept(this);
+    return hash;
+}
+
+uint64_t QueryHasher::hashScalar(const Node::Node* expr) {
+    bool outer = hashingScalar;
+    hashingScalar = true;
+    uint64_t h = hashOf(expr);
+    hashingScalar = outer;
+    return h;
+}
+
+uint64_t QueryHasher::hashBinary(uint64_t tag, const Node::Node* LHS, const Node::Node* RHS, Node::Operator op) {
+    uint64_t h = combine(tag, op);
+    h = combine(h, hashOf(LHS));
+    return combine(h, hashOf(RHS));
+}
+
+// statements other than queries are never hashed
+
+// visit script
+void QueryHasher::visit(const Node::Script* n) {}
+
+// visit create
+void QueryHasher::visit(const Node::Create* n) {}
+
+// visit name-type list
+void QueryHasher::visit(const Node::NameTypeList* n) {}
+
+// visit name-type pair
+void QueryHasher::visit(const Node::NameTypePair* n) {}
+
+// visit drop
+void QueryHasher::visit(const Node::Drop* n) {}
+
+// visit analyze
+void QueryHasher::visit(const Node::Analyze* n) {}
+
+// visit delete
+void QueryHasher::visit(const Node::Delete* n) {}
+
+// visit filter
+void QueryHasher::visit(const Node::Filter* n) {}
+
+// visit update
+void QueryHasher::visit(const Node::Update* n) {}
+
+// visit assign list
+void QueryHasher::visit(const Node::AssignList* n) {}
+
+// visit assign
+void QueryHasher::visit(const Node::Assign* n) {}
+
+// visit insert
+void QueryHasher::visit(const Node::Insert* n) {}
+
+// visit bulk insert
+void QueryHasher::visit(const Node::BulkInsert* n) {}
+
+// visit load
+void QueryHasher::visit(const Node::Load* n) {}
+
+// visit expression list
+void QueryHasher::visit(const Node::ExpressionList* n) {}
+
+// visit or expression
+void QueryHasher::visit(const Node::OrExpression* n) {
+    hash = hashBinary(orTag, n->LHS.get(), n->RHS.get(), Node::opEquals);
+}
+
+// visit and expression
+void QueryHasher::visit(const Node::AndExpression* n) {
+    hash = hashBinary(andTag, n->LHS.get(), n->RHS.get(), Node::opEquals);
+}
+
+// visit equality expression
+void QueryHasher::visit(const Node::EqualityExpression* n) {
+    hash = hashBinary(equalityTag, n->LHS.get(), n->RHS.get(), n->op);
+}
+
+// visit relational expression
+void QueryHasher::visit(const Node::RelationalExpression* n) {
+    hash = hashBinary(relationalTag, n->LHS.get(), n->RHS.get(), n->op);
+}
+
+// visit additive expression
+void QueryHasher::visit(const Node::AdditiveExpression* n) {
+    hash = hashBinary(additiveTag, n->LHS.get(), n->RHS.get(), n->op);
+}
+
+// visit multiplicative expression
+void QueryHasher::visit(const Node::MultiplicativeExpression* n) {
+    hash = hashBinary(multiplicativeTag, n->LHS.get(), n->RHS.get(), n->op);
+}
+
+// visit identifier
+void QueryHasher::visit(const Node::Identifier* n) {
+    if (hashingScalar) {
+        hash = combine(columnTag, hashName(n->name));
+        return;
+    }
+
+    // table reference
+    if (std::find(tables.begin(), tables.end(), n->name) == tables.end()) {
+        tables.push_back(n->name);
+    }
+    hash = combine(tableTag, hashName(n->name));
+}
+
+// visit int literal
+void QueryHasher::visit(const Node::IntLiteral* n) {
+    hash = hashLiteral(Value(n->value));
+}
+
+// visit float literal
+void QueryHasher::visit(const Node::FloatLiteral* n) {
+    hash = hashLiteral(Value(n->value));
+}
+
+// visit bool literal
+void QueryHasher::visit(const Node::BoolLiteral* n) {
+    hash = hashLiteral(Value(n->value));
+}
+
+// visit chars literal
+void QueryHasher::visit(const Node::CharsLiteral* n) {
+    hash = hashLiteral(Value(std::string(n->value)));
+}
+
+// visit parameter
+void QueryHasher::visit(const Node::Parameter* n) {
+    // the same query with a literal in place of the parameter hashes equal
+    hash = hashLiteral((*parameters)[n->index - 1]);
+}
+
+// visit select expression
+void QueryHasher::visit(const Node::SelectExpression* n) {
+    uint64_t h = combine(selectTag, hashOf(n->LHS.get()));
+    hash = combine(h, hashScalar(n->RHS.get()));
+}
+
+// visit project expression
+void QueryHasher::visit(const Node::ProjectExpression* n) {
+    uint64_t h = combine(projectTag, hashOf(n->LHS.get()));
+    hash = combine(h, hashOf(n->RHS.get()));
+}
+
+// visit column list
+void QueryHasher::visit(const Node::ColumnList* n) {
+    // column order is the order of the result
+    uint64_t h = combine(columnListTag, n->columns.size());
+    for (const auto& column : n->columns) {
+        h = combine(h, hashName(column->name));
+    }
+    hash = h;
+}
+
+// visit union expression
+void QueryHasher::visit(const Node::UnionExpression* n) {
+    // a | b and b | a hold the same rows but print them in a different order
+    hash = hashBinary(unionTag, n->LHS.get(), n->RHS.get(), Node::opEquals);
+}
+
+// visit difference expression
+void QueryHasher::visit(const Node::DifferenceExpression* n) {
+    hash = hashBinary(differenceTag, n->LHS.get(), n->RHS.get(), Node::opMinus);
+}
+
+// visit intersect expression
+void QueryHasher::visit(const Node::IntersectExpression* n) {
+    // a & b and b & a hold the same rows but print them in a different order
+    hash = hashBinary(intersectTag, n->LHS.get(), n->RHS.get(), Node::opEquals);
+}
+
+// visit join expression
+void QueryHasher::visit(const Node::JoinExpression* n) {
+    // column order follows the operands, so a ^ b and b ^ a differ
+    hash = hashBinary(joinTag, n->LHS.get(), n->RHS.get(), Node::opEquals);
+}
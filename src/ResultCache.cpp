@@ -0,0 +1,48 @@
+// ResultCache.cpp
+
+#include "microRDB/ResultCache.hpp"
+
+const Table* ResultCache::find(uint64_t key, const std::string& text, const Catalog& catalog) {
+    ++numLookups;
+    auto found = index.find(key);
+    if (found == index.end() || found->second->text != text) {
+        return nullptr;
+    }
+
+    // stale once any table it read was written, dropped or recreated
+    for (const auto& tableVersion : found->second->tableVersions) {
+        if (catalog.dataVersion(tableVersion.first) != tableVersion.second) {
+            entries.erase(found->second);
+            index.erase(found);
+            return nullptr;
+        }
+    }
+
+    entries.splice(entries.begin(), entries, found->second);
+    ++numHits;
+    return &entries.front().result;
+}
+
+void ResultCache::insert(uint64_t key, const std::string& text, const std::vector<std::string>& tables, const Catalog& catalog,
+                         const Table& result) {
+    if (capacity == 0 || result.rows.size() > maxRows) {
+        return;
+    }
+
+    auto found = index.find(key);
+    if (found != index.end()) {
+        entries.erase(found->second);
+        index.erase(found);
+    }
+    if (entries.size() == capacity) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+
+    Entry entry{key, text, {}, result};
+    for (const auto& table : tables) {
+        entry.tableVersions.push_back({table, catalog.dataVersion(table)});
+    }
+    entries.push_front(std::move(entry));
+    index[key] = entries.begin();
+}
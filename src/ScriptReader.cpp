@@ -0,0 +1,91 @@
+// ScriptReader.cpp
+
+#include <algorithm>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "microRDB/ScriptReader.hpp"
+
+ScriptReader::ScriptReader(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat status;
+    if (fd == -1 || fstat(fd, &status) == -1) {
+        std::cout << "Could not open script file \"" << path << "\". Terminating.\n";
+        exit(1);
+    }
+
+    // an empty file cannot be mapped
+    mappedSize = status.st_size;
+    if (mappedSize > 0) {
+        void* address = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            std::cout << "Could not map script file \"" << path << "\". Terminating.\n";
+            exit(1);
+        }
+        mapped = static_cast<const char*>(address);
+        madvise(address, mappedSize, MADV_SEQUENTIAL);
+    }
+    close(fd);
+
+    text = std::string_view(mapped, mappedSize);
+}
+
+ScriptReader::ScriptReader(std::istream& stream)
+    : stream(&stream) {}
+
+ScriptReader::~ScriptReader() {
+    if (mapped != nullptr) {
+        munmap(const_cast<char*>(mapped), mappedSize);
+    }
+}
+
+bool ScriptReader::refill() {
+    if (stream == nullptr || !*stream) {
+        return false;
+    }
+
+    // drop consumed statements so the buffer only grows with statement size
+    buffer.erase(0, position);
+    position = 0;
+
+    size_t oldSize = buffer.size();
+    buffer.resize(oldSize + chunkSize);
+    stream->read(&buffer[oldSize], chunkSize);
+    buffer.resize(oldSize + stream->gcount());
+    text = buffer;
+
+    return buffer.size() > oldSize;
+}
+
+void ScriptReader::advance(size_t end) {
+    statementLine = lineNumber;
+    lineNumber += std::count(text.begin() + position, text.begin() + end, '\n');
+    position = end;
+}
+
+bool ScriptReader::next(std::string_view& statement) {
+    while (true) {
+        size_t end = lexer.findStatementEnd(text, position);
+        if (end != std::string_view::npos) {
+            statement = text.substr(position, end - position);
+            advance(end);
+            return true;
+        }
+
+        // statement continues past what has been read, rescan it once more is available
+        if (!refill()) {
+            break;
+        }
+    }
+
+    if (position == text.size()) {
+        return false;
+    }
+
+    // trailing text without a ;
+    statement = text.substr(position);
+    advance(text.size());
+    return true;
+}
@@ -0,0 +1,131 @@
+// Session.cpp
+
+#include <iostream>
+#include "microRDB/Binder.hpp"
+#include "microRDB/Parser.hpp"
+#include "microRDB/Session.hpp"
+
+Session::Session(Catalog& catalog, const ExecutionOptions& options)
+    : catalog(catalog), executor(catalog, options), queryOptions(options) {
+    queryOptions.walPath.clear();
+    queryOptions.lsmPath.clear();
+    queryOptions.resultCacheSize = 0;
+}
+
+Session::~Session() {
+    if (readsSnapshots) {
+        catalog.closeSnapshotReader();
+    }
+}
+
+std::string Session::normalize(const std::vector<TokenView>& tokens) {
+    std::string normalized;
+    for (const auto& token : tokens) {
+        if (!normalized.empty()) {
+            normalized += ' ';
+        }
+        if (token.type == Token::charsLiteral) {
+            normalized += '\"';
+            normalized += token.value;
+            normalized += '\"';
+        }
+        else {
+            normalized += token.value;
+        }
+    }
+    return normalized;
+}
+
+PreparedStatement& Session::prepare(const std::string& text) {
+    auto seen = seenTexts.find(text);
+    if (seen != seenTexts.end()) {
+        ++hits;
+        return *seen->second;
+    }
+
+    auto tokens = lexer.lexViews(text);
+    std::string normalized = normalize(tokens);
+    auto& statement = statements[normalized];
+    if (statement) {
+        ++hits;
+    }
+    else {
+        ++misses;
+        Parser p(tokens);
+        statement = std::make_unique<PreparedStatement>();
+        statement->normalizedText = normalized;
+        statement->script = p.parse();
+        statement->numParameters = p.numParameters();
+        statement->boundSchemaVersions.assign(statement->script->statements.size(), PreparedStatement::unbound);
+    }
+
+    // the exact texts are only a shortcut, forgetting them all keeps the map bounded
+    if (seenTexts.size() >= maxSeenTexts) {
+        seenTexts.clear();
+    }
+    seenTexts.emplace(text, statement.get());
+    return *statement;
+}
+
+void Session::checkParameters(PreparedStatement& statement, const std::vector<Value>& parameters) {
+    if (parameters.size() != statement.numParameters) {
+        std::cout << "Execution error. Statement expects " << statement.numParameters << " parameters, got "
+                  << parameters.size() << ". Terminating.\n";
+        exit(1);
+    }
+
+    // a binding holds column ordinals and types, it stays valid until the schema or a parameter type changes
+    std::vector<Value::Type> parameterTypes;
+    parameterTypes.reserve(parameters.size());
+    for (const auto& parameter : parameters) {
+        parameterTypes.push_back(parameter.type);
+    }
+    if (parameterTypes != statement.boundParameterTypes) {
+        statement.boundSchemaVersions.assign(statement.boundSchemaVersions.size(), PreparedStatement::unbound);
+        statement.boundParameterTypes = parameterTypes;
+    }
+}
+
+void Session::bind(PreparedStatement& statement, size_t i, const Catalog& schema, const std::vector<Value>& parameters) {
+    if (statement.boundSchemaVersions[i] != schema.schemaVersion()) {
+        Binder binder(schema, &parameters);
+        statement.script->statements[i]->accept(&binder);
+        statement.boundSchemaVersions[i] = schema.schemaVersion();
+    }
+}
+
+void Session::execute(PreparedStatement& statement, const std::vector<Value>& parameters) {
+    checkParameters(statement, parameters);
+    bool transaction = executor.beginTransaction();
+    const auto& statements = statement.script->statements;
+    for (size_t i = 0; i < statements.size(); ++i) {
+        bind(statement, i, catalog, parameters);
+        executor.execute(statements[i].get(), &parameters);
+    }
+    if (transaction) {
+        executor.commit();
+    }
+}
+
+void Session::query(PreparedStatement& statement, const std::vector<Value>& parameters) {
+    checkParameters(statement, parameters);
+    const auto& statements = statement.script->statements;
+    for (const auto& node : statements) {
+        if (!Executor::isQuery(node.get())) {
+            std::cout << "Execution error. Only queries run on a snapshot. Terminating.\n";
+            exit(1);
+        }
+    }
+
+    // the first query waits for the statement running on the catalog, later ones take the published state
+    if (!readsSnapshots) {
+        catalog.openSnapshotReader();
+        readsSnapshots = true;
+    }
+    std::unique_ptr<Catalog> snapshot = catalog.snapshot();
+    Executor reader(*snapshot, queryOptions);
+    for (size_t i = 0; i < statements.size(); ++i) {
+        bind(statement, i, *snapshot, parameters);
+        reader.execute(statements[i].get(), &parameters);
+    }
+}
@@ -0,0 +1,295 @@
+// StatementWriter.cpp
+
+#include <charconv>
+#include <iostream>
+#include "microRDB/StatementWriter.hpp"
+
+std::string StatementWriter::write(const Node::Node* statement) {
+    text.clear();
+    statement->accept(this);
+    text += ";";
+    return text;
+}
+
+std::string StatementWriter::writeInsert(const std::string& tableName, const std::vector<Row>& rows, size_t begin, size_t end) {
+    text = tableName;
+    for (size_t r = begin; r < end; ++r) {
+        text += " <- ";
+        for (size_t c = 0; c < rows[r].size(); ++c) {
+            if (c > 0) {
+                text += ", ";
+            }
+            writeValue(rows[r][c]);
+        }
+    }
+    text += ";";
+    return text;
+}
+
+void StatementWriter::writeValue(const Value& v) {
+    switch (v.type) {
+        case Value::intType:
+            text += std::to_string(v.intValue);
+            break;
+        case Value::floatType: {
+            // the shortest digits of the float widened to double parse back to exactly the same float
+            char digits[512];
+            auto end = std::to_chars(digits, digits + sizeof(digits), double(v.floatValue), std::chars_format::fixed).ptr;
+            std::string number(digits, end);
+            if (number.find('.') == std::string::npos) {
+                number += ".0";
+            }
+            text += number;
+            break;
+        }
+        case Value::boolType:
+            text += v.boolValue ? "true" : "false";
+            break;
+        case Value::charsType:
+            // chars literals have no escapes
+            if (v.charsValue.find('\"') != std::string::npos) {
+                std::cout << "Log error. The value " << v.charsValue << " cannot be written as a chars literal. Terminating.\n";
+                exit(1);
+            }
+            text += "\"" + v.charsValue + "\"";
+            break;
+    }
+}
+
+void StatementWriter::writeBinary(const Node::Node* LHS, const char* op, const Node::Node* RHS) {
+    text += "(";
+    LHS->accept(this);
+    text += " ";
+    text += op;
+    text += " ";
+    RHS->accept(this);
+    text += ")";
+}
+
+// visit script
+void StatementWriter::visit(const Node::Script* n) {
+    for (size_t i = 0; i < n->statements.size(); ++i) {
+        if (i > 0) {
+            text += "; ";
+        }
+        n->statements[i]->accept(this);
+    }
+}
+
+// visit create
+void StatementWriter::visit(const Node::Create* n) {
+    text += n->tableName + (n->maintained ? " == " : " = ");
+    n->expression->accept(this);
+}
+
+// visit name-type list
+void StatementWriter::visit(const Node::NameTypeList* n) {
+    for (size_t i = 0; i < n->nameTypePairs.size(); ++i) {
+        if (i > 0) {
+            text += ", ";
+        }
+        n->nameTypePairs[i]->accept(this);
+    }
+}
+
+// visit name-type pair
+void StatementWriter::visit(const Node::NameTypePair* n) {
+    text += n->name + " : " + n->type;
+    if (!n->numChars.empty()) {
+        text += " " + n->numChars;
+    }
+}
+
+// visit drop
+void StatementWriter::visit(const Node::Drop* n) {
+    text += n->tableName + " ~";
+}
+
+// visit analyze
+void StatementWriter::visit(const Node::Analyze* n) {
+    text += n->tableName + " @";
+}
+
+// visit delete
+void StatementWriter::visit(const Node::Delete* n) {
+    text += n->tableName + " !";
+    for (const auto& filter : n->filters) {
+        filter->accept(this);
+    }
+}
+
+// visit filter
+void StatementWriter::visit(const Node::Filter* n) {
+    text += " ? ";
+    n->expr->accept(this);
+}
+
+// visit update
+void StatementWriter::visit(const Node::Update* n) {
+    text += n->tableName + " := ";
+    n->assignList->accept(this);
+    for (const auto& filter : n->filters) {
+        filter->accept(this);
+    }
+}
+
+// visit assign list
+void StatementWriter::visit(const Node::AssignList* n) {
+    for (size_t i = 0; i < n->assigns.size(); ++i) {
+        if (i > 0) {
+            text += ", ";
+        }
+        n->assigns[i]->accept(this);
+    }
+}
+
+// visit assign
+void StatementWriter::visit(const Node::Assign* n) {
+    text += n->name + " (";
+    n->expr->accept(this);
+    text += ")";
+}
+
+// visit insert
+void StatementWriter::visit(const Node::Insert* n) {
+    text += n->tableName;
+    for (const auto& expressionList : n->expressionLists) {
+        text += " <- ";
+        expressionList->accept(this);
+    }
+}
+
+// visit bulk insert
+void StatementWriter::visit(const Node::BulkInsert* n) {
+    text += n->tableName;
+    for (size_t r = 0; r < n->numRows; ++r) {
+        text += " <- ";
+        for (size_t c = 0; c < n->numColumns; ++c) {
+            if (c > 0) {
+                text += ", ";
+            }
+            const Node::Literal& literal = n->row(r)[c];
+            switch (literal.type) {
+                case Node::Literal::intType: writeValue(Value(literal.intValue)); break;
+                case Node::Literal::floatType: writeValue(Value(literal.floatValue)); break;
+                case Node::Literal::boolType: writeValue(Value(literal.boolValue)); break;
+                case Node::Literal::charsType: writeValue(Value(std::string(literal.charsValue))); break;
+            }
+        }
+    }
+}
+
+// visit load
+void StatementWriter::visit(const Node::Load* n) {
+    text += n->tableName + " << \"" + std::string(n->path) + "\"";
+}
+
+// visit expression list
+void StatementWriter::visit(const Node::ExpressionList* n) {
+    for (size_t i = 0; i < n->expressions.size(); ++i) {
+        if (i > 0) {
+            text += ", ";
+        }
+        n->expressions[i]->accept(this);
+    }
+}
+
+// visit or expression
+void StatementWriter::visit(const Node::OrExpression* n) {
+    writeBinary(n->LHS.get(), "||", n->RHS.get());
+}
+
+// visit and expression
+void StatementWriter::visit(const Node::AndExpression* n) {
+    writeBinary(n->LHS.get(), "&&", n->RHS.get());
+}
+
+// visit equality expression
+void StatementWriter::visit(const Node::EqualityExpression* n) {
+    writeBinary(n->LHS.get(), Node::operatorString(n->op), n->RHS.get());
+}
+
+// visit relational expression
+void StatementWriter::visit(const Node::RelationalExpression* n) {
+    writeBinary(n->LHS.get(), Node::operatorString(n->op), n->RHS.get());
+}
+
+// visit additive expression
+void StatementWriter::visit(const Node::AdditiveExpression* n) {
+    writeBinary(n->LHS.get(), Node::operatorString(n->op), n->RHS.get());
+}
+
+// visit multiplicative expression
+void StatementWriter::visit(const Node::MultiplicativeExpression* n) {
+    writeBinary(n->LHS.get(), Node::operatorString(n->op), n->RHS.get());
+}
+
+// visit identifier
+void StatementWriter::visit(const Node::Identifier* n) {
+    text += n->name;
+}
+
+// visit int literal
+void StatementWriter::visit(const Node::IntLiteral* n) {
+    writeValue(Value(n->value));
+}
+
+// visit float literal
+void StatementWriter::visit(const Node::FloatLiteral* n) {
+    writeValue(Value(n->value));
+}
+
+// visit bool literal
+void StatementWriter::visit(const Node::BoolLiteral* n) {
+    writeValue(Value(n->value));
+}
+
+// visit chars literal
+void StatementWriter::visit(const Node::CharsLiteral* n) {
+    writeValue(Value(std::string(n->value)));
+}
+
+// visit parameter
+void StatementWriter::visit(const Node::Parameter* n) {
+    writeValue((*parameters)[n->index - 1]);
+}
+
+// visit select expression
+void StatementWriter::visit(const Node::SelectExpression* n) {
+    writeBinary(n->LHS.get(), "?", n->RHS.get());
+}
+
+// visit project expression
+void StatementWriter::visit(const Node::ProjectExpression* n) {
+    writeBinary(n->LHS.get(), "->", n->RHS.get());
+}
+
+// visit column list
+void StatementWriter::visit(const Node::ColumnList* n) {
+    for (size_t i = 0; i < n->columns.size(); ++i) {
+        if (i > 0) {
+            text += ", ";
+        }
+        text += n->columns[i]->name;
+    }
+}
+
+// visit union expression
+void StatementWriter::visit(const Node::UnionExpression* n) {
+    writeBinary(n->LHS.get(), "|", n->RHS.get());
+}
+
+// visit difference expression
+void StatementWriter::visit(const Node::DifferenceExpression* n) {
+    writeBinary(n->LHS.get(), "-", n->RHS.get());
+}
+
+// visit intersect expression
+void StatementWriter::visit(const Node::IntersectExpression* n) {
+    writeBinary(n->LHS.get(), "&", n->RHS.get());
+}
+
+// visit join expression
+void StatementWriter::visit(const Node::JoinExpression* n) {
+    writeBinary(n->LHS.get(), "^", n->RHS.get());
+}
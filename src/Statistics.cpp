@@ -0,0 +1,274 @@
+// Statistics.cpp
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "microRDB/Statistics.hpp"
+
+// HyperLogLog
+
+void HyperLogLog::add(uint64_t hash) {
+    size_t index = hash >> (64 - precision);
+
+    // rank is the position of the first set bit in the remaining bits, guard bit bounds the loop
+    uint64_t remaining = (hash << precision) | (1ULL << (precision - 1));
+    uint8_t rank = 1;
+    while (!(remaining & (1ULL << 63))) {
+        ++rank;
+        remaining <<= 1;
+    }
+
+    registers[index] = std::max(registers[index], rank);
+}
+
+double HyperLogLog::estimate() const {
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (auto r : registers) {
+        sum += std::ldexp(1.0, -static_cast<int>(r));
+        if (r == 0) {
+            ++zeros;
+        }
+    }
+
+    double m = numRegisters;
+    double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+
+    // small range correction: linear counting
+    if (estimate <= 2.5 * m && zeros != 0) {
+        estimate = m * std::log(m / zeros);
+    }
+    return estimate;
+}
+
+void HyperLogLog::clear() {
+    std::fill(registers.begin(), registers.end(), 0);
+}
+
+// EquiDepthHistogram
+
+size_t EquiDepthHistogram::bucketOf(double value) const {
+    // interior bounds decide the bucket, values outside the range land in the first/last bucket
+    auto interior = std::upper_bound(bounds.begin() + 1, bounds.end() - 1, value);
+    return interior - (bounds.begin() + 1);
+}
+
+void EquiDepthHistogram::split(size_t bucket) {
+    double lo = bounds[bucket];
+    double hi = bounds[bucket + 1];
+
+    // a single heavy value cannot be split
+    if (lo == hi) {
+        return;
+    }
+
+    // assume uniformity within the bucket
+    double half = counts[bucket] / 2.0;
+    counts[bucket] = half;
+    counts.insert(counts.begin() + bucket + 1, half);
+    bounds.insert(bounds.begin() + bucket + 1, lo + (hi - lo) / 2.0);
+}
+
+void EquiDepthHistogram::mergeSmallest() {
+    size_t best = 0;
+    for (size_t i = 1; i + 1 < counts.size(); ++i) {
+        if (counts[i] + counts[i + 1] < counts[best] + counts[best + 1]) {
+            best = i;
+        }
+    }
+
+    counts[best] += counts[best + 1];
+    counts.erase(counts.begin() + best + 1);
+    bounds.erase(bounds.begin() + best + 1);
+}
+
+void EquiDepthHistogram::build(std::vector<double> values) {
+    clear();
+    if (values.empty()) {
+        return;
+    }
+
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    size_t k = std::min(maxBuckets, n);
+
+    // bucket boundaries at the k-quantiles
+    bounds.resize(k + 1);
+    for (size_t i = 0; i < k; ++i) {
+        bounds[i] = values[i * n / k];
+    }
+    bounds[k] = values.back();
+
+    counts.assign(k, 0.0);
+    for (auto value : values) {
+        ++counts[bucketOf(value)];
+    }
+    total = n;
+}
+
+void EquiDepthHistogram::add(double value) {
+    if (empty()) {
+        bounds = {value, value};
+        counts = {1.0};
+        total = 1.0;
+        return;
+    }
+
+    bounds.front() = std::min(bounds.front(), value);
+    bounds.back() = std::max(bounds.back(), value);
+
+    size_t bucket = bucketOf(value);
+    ++counts[bucket];
+    ++total;
+
+    // keep buckets near equal depth
+    if (counts[bucket] > 2.0 * total / maxBuckets) {
+        split(bucket);
+        while (counts.size() > maxBuckets) {
+            mergeSmallest();
+        }
+    }
+}
+
+void EquiDepthHistogram::remove(double value) {
+    if (empty()) {
+        return;
+    }
+
+    size_t bucket = bucketOf(value);
+    counts[bucket] = std::max(0.0, counts[bucket] - 1.0);
+    total = std::max(0.0, total - 1.0);
+}
+
+void EquiDepthHistogram::clear() {
+    bounds.clear();
+    counts.clear();
+    total = 0.0;
+}
+
+double EquiDepthHistogram::fractionBelow(double value, bool inclusive) const {
+    if (empty() || total <= 0.0) {
+        return 0.0;
+    }
+    if (value < bounds.front() || (value == bounds.front() && !inclusive)) {
+        return 0.0;
+    }
+    if (value > bounds.back() || (value == bounds.back() && inclusive)) {
+        return 1.0;
+    }
+
+    double below = 0.0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        double lo = bounds[i];
+        double hi = bounds[i + 1];
+        if (hi < value) {
+            below += counts[i];
+            continue;
+        }
+
+        // partial bucket, interpolate
+        if (lo <= value) {
+            if (hi == lo) {
+                below += inclusive ? counts[i] : 0.0;
+            }
+            else {
+                below += counts[i] * (value - lo) / (hi - lo);
+            }
+        }
+        break;
+    }
+
+    return std::min(1.0, below / total);
+}
+
+// TableStatistics
+
+void TableStatistics::analyze(const Table& table) {
+    rowCount = table.rows.size() - table.deleted.count();
+    modificationsSinceAnalyze = 0;
+    columns.assign(table.columns.size(), ColumnStatistics());
+
+    for (size_t c = 0; c < table.columns.size(); ++c) {
+        ColumnStatistics& column = columns[c];
+        column.hasHistogram = table.columns[c].type != Value::charsType;
+
+        std::vector<double> values;
+        values.reserve(column.hasHistogram ? rowCount : 0);
+        for (size_t r = table.deleted.nextLive(0); r < table.rows.size(); r = table.deleted.nextLive(r + 1)) {
+            column.sketch.add(table.rows[r][c].hash());
+            if (column.hasHistogram) {
+                values.push_back(table.rows[r][c].asDouble());
+            }
+        }
+        column.histogram.build(std::move(values));
+    }
+}
+
+void TableStatistics::onInsert(const Row& row) {
+    ++rowCount;
+    for (size_t c = 0; c < columns.size(); ++c) {
+        columns[c].sketch.add(row[c].hash());
+        if (columns[c].hasHistogram) {
+            columns[c].histogram.add(row[c].asDouble());
+        }
+    }
+}
+
+void TableStatistics::onDelete(const Row& row) {
+    if (rowCount > 0) {
+        --rowCount;
+    }
+    ++modificationsSinceAnalyze;
+    for (size_t c = 0; c < columns.size(); ++c) {
+        if (columns[c].hasHistogram) {
+            columns[c].histogram.remove(row[c].asDouble());
+        }
+    }
+}
+
+void TableStatistics::onUpdate(const Row& oldRow, const Row& newRow) {
+    onUpdateRows(1);
+    for (size_t c = 0; c < columns.size(); ++c) {
+        onUpdateCell(c, oldRow[c], newRow[c]);
+    }
+}
+
+void TableStatistics::onUpdateRows(size_t numRows) {
+    modificationsSinceAnalyze += numRows;
+}
+
+void TableStatistics::onUpdateCell(size_t column, const Value& oldValue, const Value& newValue) {
+    if (oldValue == newValue) {
+        return;
+    }
+    columns[column].sketch.add(newValue.hash());
+    if (columns[column].hasHistogram) {
+        columns[column].histogram.remove(oldValue.asDouble());
+        columns[column].histogram.add(newValue.asDouble());
+    }
+}
+
+bool TableStatistics::needsAnalyze() const {
+    // same shape as a base threshold plus scale factor autoanalyze
+    return modificationsSinceAnalyze > 50 + rowCount / 10;
+}
+
+double TableStatistics::distinctValues(size_t column) const {
+    if (rowCount == 0 || column >= columns.size()) {
+        return 0.0;
+    }
+    double estimate = columns[column].sketch.estimate();
+    return std::max(1.0, std::min(estimate, static_cast<double>(rowCount)));
+}
+
+void TableStatistics::print(const Table& table) const {
+    std::cout << rowCount << (rowCount == 1 ? " row\n" : " rows\n");
+    for (size_t c = 0; c < columns.size() && c < table.columns.size(); ++c) {
+        std::cout << "  " << table.columns[c].name << ": ~" << std::llround(distinctValues(c)) << " distinct";
+        if (columns[c].hasHistogram) {
+            std::cout << ", " << columns[c].histogram.numBuckets() << " histogram buckets";
+        }
+        std::cout << "\n";
+    }
+}
@@ -0,0 +1,78 @@
+// Table.cpp
+
+#include <iostream>
+#include "microRDB/Table.hpp"
+
+int Table::columnIndex(const std::string& name) const {
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (columns[i].name == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool Table::isUnionCompatible(const Table& other) const {
+    if (columns.size() != other.columns.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (columns[i].type != other.columns[i].type) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Table::print() const {
+    // header
+    for (size_t i = 0; i < columns.size(); ++i) {
+        std::cout << (i == 0 ? "" : " | ") << columns[i].name;
+    }
+    std::cout << "\n";
+
+    // rows
+    for (const auto& row : rows) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            std::cout << (i == 0 ? "" : " | ") << row[i].toString();
+        }
+        std::cout << "\n";
+    }
+    std::cout << "(" << rows.size() << (rows.size() == 1 ? " row)\n" : " rows)\n");
+}
+
+Table Table::live() const {
+    if (deleted.empty()) {
+        return *this;
+    }
+
+    Table output;
+    output.columns = columns;
+    output.rows.reserve(rows.size() - deleted.count());
+    for (size_t r = deleted.nextLive(0); r < rows.size(); r = deleted.nextLive(r + 1)) {
+        output.rows.push_back(rows[r]);
+    }
+    return output;
+}
+
+size_t Table::compact(size_t from, size_t maxRows) {
+    // rows from gap up to next are all deleted, the next live row moves to the start of the gap
+    size_t gap = deleted.nextDeleted(from, rows.size());
+    size_t next = deleted.nextLive(gap);
+    for (size_t moved = 0; next < rows.size() && moved < maxRows; ++moved) {
+        rows[gap] = std::move(rows[next]);
+        deleted.erase(gap);
+        deleted.insert(next);
+        gap = deleted.nextDeleted(gap + 1, rows.size());
+        next = deleted.nextLive(next + 1);
+    }
+    if (next < rows.size()) {
+        return gap;
+    }
+
+    // only deleted rows are left from the gap on
+    rows.resize(gap);
+    deleted.truncate(gap);
+    return rows.size();
+}
@@ -0,0 +1,114 @@
+// ThreadPool.cpp
+
+#include <algorithm>
+#include "microRDB/ThreadPool.hpp"
+
+ThreadPool::ThreadPool(size_t numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (size_t i = 0; i < numThreads; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+
+    // the thread calling parallelFor acts as worker 0
+    for (size_t i = 1; i < numThreads; ++i) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+bool ThreadPool::tryRun(size_t self) {
+    std::function<void()> task;
+    for (size_t i = 0; i < workers.size() && !task; ++i) {
+        Worker& victim = *workers[(self + i) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+        else {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+    --queued;
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t self) {
+    while (true) {
+        if (tryRun(self)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t morselSize, const std::function<void(size_t morsel, size_t begin, size_t end)>& body) {
+    if (morselSize == 0) {
+        morselSize = 1;
+    }
+    size_t numMorsels = (count + morselSize - 1) / morselSize;
+
+    // not worth scheduling
+    if (numMorsels <= 1 || workers.size() == 1) {
+        for (size_t m = 0; m < numMorsels; ++m) {
+            body(m, m * morselSize, std::min(count, (m + 1) * morselSize));
+        }
+        return;
+    }
+
+    std::atomic<size_t> remaining{numMorsels};
+    std::mutex doneMutex;
+    std::condition_variable done;
+
+    for (size_t m = 0; m < numMorsels; ++m) {
+        Worker& owner = *workers[m % workers.size()];
+        std::lock_guard<std::mutex> lock(owner.mutex);
+        owner.tasks.push_back([&, m] {
+            body(m, m * morselSize, std::min(count, (m + 1) * morselSize));
+
+            // decrement under the lock so the waiter cannot return and destroy it first
+            std::lock_guard<std::mutex> doneLock(doneMutex);
+            if (--remaining == 0) {
+                done.notify_all();
+            }
+        });
+        ++queued;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_all();
+
+    // help until nothing is left to take, then wait for stragglers
+    while (remaining > 0 && tryRun(0)) {
+    }
+    std::unique_lock<std::mutex> lock(doneMutex);
+    done.wait(lock, [&] { return remaining == 0; });
+}
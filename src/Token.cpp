@@ -38,6 +38,7 @@ std::string Token::toString() const {
         case questionMark: return "question mark";
         case opWalrus: return "walrus operator";
         case arrowLeft: return "left arrow";
+        case chevronLeft: return "left chevron";
         case arrowRight: return "right arrow";
         case opUnion: return "union";
         case opIntersect: return "intersection";
@@ -53,3 +54,7 @@ std::string Token::toString() const {
         default: return "unknown token";
     }
 }
+
+std::string TokenView::toString() const {
+    return Token(type).toString();
+}
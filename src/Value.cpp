@@ -0,0 +1,111 @@
+// Value.cpp
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include "microRDB/Value.hpp"
+
+namespace {
+    // splitmix64 finalizer
+    uint64_t mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+}
+
+double Value::asDouble() const {
+    switch (type) {
+        case intType: return intValue;
+        case floatType: return floatValue;
+        case boolType: return boolValue ? 1.0 : 0.0;
+        default: return 0.0;
+    }
+}
+
+size_t Value::hash() const {
+    switch (type) {
+        case intType: return mix(static_cast<uint64_t>(static_cast<uint32_t>(intValue)));
+        case floatType: {
+            // values that compare equal hash equal, -0.0 as 0.0 and every nan as one pattern
+            uint32_t bits = 0;
+            if (floatValue != floatValue) {
+                bits = 0x7fc00000;
+            }
+            else if (floatValue != 0.0f) {
+                std::memcpy(&bits, &floatValue, sizeof(bits));
+            }
+            return mix(bits ^ 0x100000000ULL);
+        }
+        case boolType: return mix(boolValue ? 0x200000001ULL : 0x200000000ULL);
+        case charsType: return mix(std::hash<std::string>()(charsValue));
+        default: return 0;
+    }
+}
+
+std::string Value::toString() const {
+    switch (type) {
+        case intType: return std::to_string(intValue);
+        case floatType: {
+            std::ostringstream out;
+            out << floatValue;
+            return out.str();
+        }
+        case boolType: return boolValue ? "true" : "false";
+        case charsType: return charsValue;
+        default: return "unknown value";
+    }
+}
+
+std::string Value::typeName(Type type) {
+    switch (type) {
+        case intType: return "int";
+        case floatType: return "float";
+        case boolType: return "bool";
+        case charsType: return "chars";
+        default: return "unknown type";
+    }
+}
+
+bool operator==(const Value& lhs, const Value& rhs) {
+    if (lhs.type != rhs.type) {
+        return false;
+    }
+
+    switch (lhs.type) {
+        case Value::intType: return lhs.intValue == rhs.intValue;
+        case Value::floatType: return lhs.floatValue == rhs.floatValue;
+        case Value::boolType: return lhs.boolValue == rhs.boolValue;
+        case Value::charsType: return lhs.charsValue == rhs.charsValue;
+        default: return false;
+    }
+}
+
+bool operator!=(const Value& lhs, const Value& rhs) {
+    return !(lhs == rhs);
+}
+
+bool operator<(const Value& lhs, const Value& rhs) {
+    if (lhs.type != rhs.type) {
+        return lhs.type < rhs.type;
+    }
+
+    switch (lhs.type) {
+        case Value::intType: return lhs.intValue < rhs.intValue;
+        case Value::floatType: return lhs.floatValue < rhs.floatValue;
+        case Value::boolType: return lhs.boolValue < rhs.boolValue;
+        case Value::charsType: return lhs.charsValue < rhs.charsValue;
+        default: return false;
+    }
+}
+
+size_t RowHash::operator()(const Row& row) const {
+    size_t seed = row.size();
+    for (const auto& value : row) {
+        seed ^= value.hash() + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
@@ -0,0 +1,45 @@
+// VersionCollector.cpp
+
+#include <algorithm>
+#include <iterator>
+#include "microRDB/VersionCollector.hpp"
+
+VersionCollector::VersionCollector()
+    : thread(&VersionCollector::collectLoop, this) {}
+
+VersionCollector::~VersionCollector() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    thread.join();
+}
+
+void VersionCollector::retire(std::shared_ptr<const void> version) {
+    std::lock_guard<std::mutex> lock(mutex);
+    retired.push_back(std::move(version));
+}
+
+size_t VersionCollector::numRetired() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return retired.size();
+}
+
+void VersionCollector::collectLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        wake.wait_for(lock, interval, [this] { return stopping; });
+
+        // a version only the collector holds is unreachable, nothing can take a new reference to it
+        std::vector<std::shared_ptr<const void>> unreachable;
+        auto held = std::partition(retired.begin(), retired.end(), [](const auto& version) { return version.use_count() > 1; });
+        std::move(held, retired.end(), std::back_inserter(unreachable));
+        retired.erase(held, retired.end());
+
+        // freed without the lock, so retiring never waits on a large free
+        lock.unlock();
+        unreachable.clear();
+        lock.lock();
+    }
+}
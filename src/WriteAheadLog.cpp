@@ -0,0 +1,97 @@
+// WriteAheadLog.cpp
+
+#include <cerrno>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "microRDB/WriteAheadLog.hpp"
+
+namespace {
+    void logError(const std::string& message, const std::string& path) {
+        std::cout << "Log error. " << message << " \"" << path << "\". Terminating.\n";
+        exit(1);
+    }
+}
+
+WriteAheadLog::WriteAheadLog(const std::string& path)
+    : path(path) {
+    fd = open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (fd == -1) {
+        logError("Could not open log file", path);
+    }
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    close(fd);
+}
+
+std::string WriteAheadLog::recover(const std::string& path) {
+    int fd = open(path.c_str(), O_RDWR);
+    if (fd == -1) {
+        if (errno != ENOENT) {
+            logError("Could not open log file", path);
+        }
+        return "";
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) == -1) {
+        logError("Could not read log file", path);
+    }
+    std::string text(status.st_size, '\0');
+    size_t done = 0;
+    while (done < text.size()) {
+        ssize_t n = read(fd, &text[done], text.size() - done);
+        if (n <= 0) {
+            logError("Could not read log file", path);
+        }
+        done += n;
+    }
+
+    // records after the last commit marker belong to a transaction that never committed
+    size_t marker = text.rfind(commitMarker);
+    size_t committed = marker == std::string::npos ? 0 : marker + commitMarker.size();
+    if (committed < text.size()) {
+        if (ftruncate(fd, committed) == -1 || fsync(fd) == -1) {
+            logError("Could not truncate log file", path);
+        }
+        text.resize(committed);
+    }
+    close(fd);
+    return text;
+}
+
+void WriteAheadLog::append(const std::string& record) {
+    pending += record;
+    pending += '\n';
+    ++numPending;
+}
+
+size_t WriteAheadLog::commit() {
+    if (numPending == 0) {
+        return 0;
+    }
+
+    pending += commitMarker;
+    size_t done = 0;
+    while (done < pending.size()) {
+        ssize_t n = write(fd, pending.data() + done, pending.size() - done);
+        if (n == -1 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            logError("Could not write log file", path);
+        }
+        done += n;
+    }
+    if (fdatasync(fd) == -1) {
+        logError("Could not sync log file", path);
+    }
+
+    size_t written = numPending;
+    pending.clear();
+    numPending = 0;
+    ++numFlushes;
+    return written;
+}
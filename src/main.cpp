@@ -1,20 +1,184 @@
 // main.cpp
 
+#include <chrono>
+#include <memory>
 #include <string>
 #include <iostream>
 #include "microRDB/Lexer.hpp"
 #include "microRDB/Parser.hpp"
 #include "microRDB/DOTVisitor.hpp"
+#include "microRDB/Catalog.hpp"
+#include "microRDB/Executor.hpp"
+#include "microRDB/FlatAst.hpp"
+#include "microRDB/ParallelParser.hpp"
+#include "microRDB/ScriptReader.hpp"
+
+namespace {
+    // lexing throughput of each lexer mode over text, repeated for at least half a second each
+    void benchmarkLexer(const std::string& text) {
+        auto measure = [&](const std::string& name, auto lexOnce) {
+            using Clock = std::chrono::steady_clock;
+            size_t runs = 0;
+            size_t numTokens = 0;
+            auto start = Clock::now();
+            std::chrono::duration<double> elapsed(0);
+            while (elapsed.count() < 0.5) {
+                numTokens = lexOnce();
+                ++runs;
+                elapsed = Clock::now() - start;
+            }
+            double gigabytesPerSecond = double(text.size()) * runs / elapsed.count() / 1e9;
+            std::cout << "lexer benchmark: " << name << " " << gigabytesPerSecond << " GB/s ("
+                      << numTokens << " tokens, " << runs << " runs)\n";
+        };
+
+        measure("lex, owning tokens", [&] { return Lexer(false).lex(text).size(); });
+        measure("lexViews, scalar", [&] { return Lexer(false).lexViews(text).size(); });
+        measure("lexViews, vectorized", [&] { return Lexer(true).lexViews(text).size(); });
+    }
+
+    // lex, parse and execute one statement at a time, memory stays bounded by the largest statement
+    void runStreaming(ScriptReader& reader, const ExecutionOptions& options) {
+        Catalog catalog;
+        Executor ex(catalog, options);
+        Lexer l;
+
+        // the whole script is one transaction, not each statement's own script
+        bool transaction = ex.beginTransaction();
+        std::string_view statement;
+        while (reader.next(statement)) {
+            auto tokens = l.lexViews(statement, reader.statementLineNumber());
+
+            // only whitespace and comments
+            if (tokens.empty()) {
+                continue;
+            }
+
+            Parser p(tokens);
+            p.parse()->accept(&ex);
+        }
+        if (transaction) {
+            ex.commit();
+        }
+    }
+}
 
 int main(int argc, char** argv) {
+    // options
+    ExecutionOptions options;
+    bool lexerBenchmark = false;
+    bool streaming = false;
+    bool parallelParse = false;
+    bool flatAst = false;
+    std::string scriptPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--benchmark-lexer") {
+            lexerBenchmark = true;
+        }
+        else if (std::string(argv[i]) == "--stream") {
+            streaming = true;
+        }
+        else if (std::string(argv[i]) == "--parallel-parse") {
+            parallelParse = true;
+        }
+        else if (std::string(argv[i]) == "--flat-ast") {
+            flatAst = true;
+        }
+        else if (std::string(argv[i]) == "--explain") {
+            options.explain = true;
+        }
+        else if (std::string(argv[i]) == "--stats") {
+            options.stats = true;
+        }
+        else if (std::string(argv[i]) == "--threads" && i + 1 < argc) {
+            options.threads = std::stoul(argv[++i]);
+        }
+        else if (std::string(argv[i]) == "--morsel-size" && i + 1 < argc) {
+            options.morselSize = std::stoul(argv[++i]);
+        }
+        else if (std::string(argv[i]) == "--eager-create") {
+            options.deferCreates = false;
+        }
+        else if (std::string(argv[i]) == "--result-cache" && i + 1 < argc) {
+            options.resultCacheSize = std::stoul(argv[++i]);
+        }
+        else if (std::string(argv[i]) == "--wal" && i + 1 < argc) {
+            options.walPath = argv[++i];
+        }
+        else if (std::string(argv[i]) == "--unlogged-load") {
+            options.unloggedLoads = true;
+        }
+        else if (std::string(argv[i]) == "--script-transaction") {
+            options.scriptTransactions = true;
+        }
+        else if (std::string(argv[i]) == "--parallel-statements") {
+            options.parallelStatements = true;
+        }
+        else if (std::string(argv[i]) == "--lsm" && i + 1 < argc) {
+            options.lsmPath = argv[++i];
+        }
+        else if (argv[i][0] != '-') {
+            scriptPath = argv[i];
+        }
+    }
+
+    // parse the whole script on all threads, then execute it
+    if (parallelParse) {
+        std::unique_ptr<Node::Script> astRoot;
+        std::string inputText;
+        std::unique_ptr<ScriptReader> reader;
+        if (!scriptPath.empty()) {
+            reader = std::make_unique<ScriptReader>(scriptPath);
+        }
+        else {
+            std::getline(std::cin, inputText, '\n');
+        }
+
+        {
+            ThreadPool pool(options.threads);
+            astRoot = ParallelParser(pool).parse(reader ? reader->remaining() : std::string_view(inputText));
+        }
+
+        Catalog catalog;
+        Executor ex(catalog, options);
+        astRoot->accept(&ex);
+        return 0;
+    }
+
+    // a script file is memory mapped, --stream reads stdin in chunks
+    // statements are only scheduled together when the whole script is parsed first
+    if (!scriptPath.empty() && options.parallelStatements) {
+        ScriptReader reader(scriptPath);
+        auto tokens = Lexer().lexViews(reader.remaining());
+        Catalog catalog;
+        Executor ex(catalog, options);
+        Parser(tokens).parse()->accept(&ex);
+        return 0;
+    }
+    if (!scriptPath.empty()) {
+        ScriptReader reader(scriptPath);
+        runStreaming(reader, options);
+        return 0;
+    }
+    if (streaming) {
+        ScriptReader reader(std::cin);
+        runStreaming(reader, options);
+        return 0;
+    }
+
     // get input
     std::string inputText; 
     std::getline(std::cin, inputText, '\n');
     // std::cout << inputText << "\n";
 
-    // lex
+    if (lexerBenchmark) {
+        benchmarkLexer(inputText);
+        return 0;
+    }
+
+    // lex, tokens are views into inputText
     Lexer l;
-    auto tokens = l.lex(inputText);
+    auto tokens = l.lexViews(inputText);
     
     // print tokens
     for (const auto& token : tokens) {
@@ -26,12 +190,20 @@ int main(int argc, char** argv) {
     Parser p(tokens);
     auto astRoot = p.parse();
 
-    // DOT visitor
-    DOTVisitor dv("ast.dot");
-    Visitor* v = &dv;
-    astRoot->accept(&dv);
+    // DOT visitor, or the same output from the flat form
+    if (flatAst) {
+        FlatAst::build(astRoot.get()).writeDot("ast.dot");
+    }
+    else {
+        DOTVisitor dv("ast.dot");
+        Visitor* v = &dv;
+        astRoot->accept(&dv);
+    }
+
+    // semantic analysis and execution, the executor binds each statement right before running it
+    Catalog catalog;
+    Executor ex(catalog, options);
+    astRoot->accept(&ex);
 
-    // semantic analyis visitor
-    // execution
     return 0;
 }
@@ -0,0 +1,64 @@
+// ResultCacheTest.cpp
+// g++ -std=c++17 -pthread -Iinclude tests/ResultCacheTest.cpp $(ls src/*.cpp | grep -v main.cpp) -o result-cache-test
+
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "microRDB/ResultCache.hpp"
+#include "microRDB/Session.hpp"
+
+namespace {
+    void check(bool ok, const std::string& what) {
+        if (!ok) {
+            std::cerr << "ResultCacheTest failed: " << what << "\n";
+            exit(1);
+        }
+    }
+
+    // what f prints
+    std::string captured(const std::function<void()>& f) {
+        std::ostringstream output;
+        std::streambuf* previous = std::cout.rdbuf(output.rdbuf());
+        f();
+        std::cout.rdbuf(previous);
+        return output.str();
+    }
+
+    // an entry is only served for the text it was stored with, whatever the hash says
+    void collidingKeys() {
+        Catalog catalog;
+        Session session(catalog);
+        session.execute("t = a : int; t <- 1;");
+        Table result;
+        result.columns.push_back(Column("a", Value::intType, 0));
+        result.rows.push_back({Value(1)});
+
+        ResultCache cache(4);
+        cache.insert(42, "t;", {"t"}, catalog, result);
+        check(cache.find(42, "(t ? (a == 2));", catalog) == nullptr, "another query with the same hash");
+        check(cache.find(42, "t;", catalog) != nullptr, "the cached query");
+    }
+
+    // every query prints what it prints uncached, also after the same query with its operands swapped
+    void sameAsUncached() {
+        Catalog catalog;
+        ExecutionOptions options;
+        options.resultCacheSize = 16;
+        Session cached(catalog, options);
+        Session uncached(catalog);
+        cached.execute("a = x : int; b = x : int; a <- 1 <- 2 <- 3; b <- 3 <- 4 <- 2;");
+
+        for (const auto* query : {"a | b;", "b | a;", "a & b;", "b & a;", "a - b;", "b - a;", "a | b;", "b & a;",
+                                  "a -> x;", "(a ? x > 1) -> x;", "(a ? x > 1) | b;", "(a ? x > 1) ^ b;"}) {
+            check(captured([&] { cached.execute(query); }) == captured([&] { uncached.execute(query); }), query);
+        }
+    }
+}
+
+int main() {
+    collidingKeys();
+    std::cout << "colliding keys ok\n";
+    sameAsUncached();
+    std::cout << "same as uncached ok\n";
+}
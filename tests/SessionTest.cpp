@@ -0,0 +1,99 @@
+// SessionTest.cpp
+// g++ -std=c++17 -pthread -Iinclude tests/SessionTest.cpp $(ls src/*.cpp | grep -v main.cpp) -o session-test
+
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "microRDB/Session.hpp"
+
+namespace {
+    void check(bool ok, const std::string& what) {
+        if (!ok) {
+            std::cerr << "SessionTest failed: " << what << "\n";
+            exit(1);
+        }
+    }
+
+    // what f prints
+    std::string captured(const std::function<void()>& f) {
+        std::ostringstream output;
+        std::streambuf* previous = std::cout.rdbuf(output.rdbuf());
+        f();
+        std::cout.rdbuf(previous);
+        return output.str();
+    }
+
+    // one prepared statement runs with different values, parsed once
+    void bindings() {
+        Catalog catalog;
+        Session session(catalog);
+        session.execute("t = a : int, b : float, c : chars 4;");
+        auto& insert = session.prepare("t <- $1, $2, $3;");
+        session.execute(insert, {Value(1), Value(0.5f), Value("x")});
+        session.execute(insert, {Value(2), Value(1.5f), Value("yy")});
+        session.execute(insert, {Value(3), Value(2), Value("x")}); // int into a float column
+
+        auto& select = session.prepare("(t ? a >= $1 && c == $2) -> a, b;");
+        check(captured([&] { session.execute(select, {Value(1), Value("x")}); }) == "a | b\n1 | 0.5\n3 | 2\n(2 rows)\n",
+              "select with the first binding");
+        check(captured([&] { session.execute(select, {Value(2), Value("yy")}); }) == "a | b\n2 | 1.5\n(1 row)\n",
+              "select with the second binding");
+
+        auto& update = session.prepare("t := b (b + $2) ? a == $1;");
+        session.execute(update, {Value(2), Value(10)});
+        session.execute(update, {Value(3), Value(0.25f)});
+        check(captured([&] { session.execute("t -> a, b;"); }) == "a | b\n1 | 0.5\n2 | 11.5\n3 | 2.25\n(3 rows)\n",
+              "updates with two bindings");
+
+        session.execute("t ! ? c == $1;", {Value("x")});
+        check(captured([&] { session.execute("t -> a;"); }) == "a\n2\n(1 row)\n", "delete with a binding");
+    }
+
+    // statements are cached by their tokens, a layout change or an exact repeat is a hit
+    void cacheHits() {
+        Catalog catalog;
+        Session session(catalog);
+        session.execute("t = a : int;");
+        check(session.cacheHits() == 0 && session.cacheMisses() == 1, "first statement misses");
+
+        for (int i = 0; i < 10; ++i) {
+            session.execute("t <- $1;", {Value(i)});
+        }
+        check(session.cacheHits() == 9 && session.cacheMisses() == 2, "repeats of one text hit");
+
+        session.execute("t   <-  $1;  # same tokens", {Value(10)});
+        check(session.cacheHits() == 10 && session.cacheMisses() == 2, "a layout change hits");
+
+        session.execute("t <- 11;");
+        check(session.cacheHits() == 10 && session.cacheMisses() == 3, "a literal is a different statement");
+        check(captured([&] { session.execute("t ? a > $1;", {Value(9)}); }) == "a\n10\n11\n(2 rows)\n",
+              "rows of the cached inserts");
+    }
+
+    // a binding is redone when a parameter type or the schema changes
+    void rebinding() {
+        Catalog catalog;
+        Session session(catalog);
+        session.execute("t = a : int, b : float; t <- 1, 1.5 <- 2, 2.5;");
+        auto& select = session.prepare("t ? b > $1;");
+        check(captured([&] { session.execute(select, {Value(2)}); }) == "a | b\n2 | 2.5\n(1 row)\n", "int parameter");
+        check(captured([&] { session.execute(select, {Value(1.25f)}); }) == "a | b\n1 | 1.5\n2 | 2.5\n(2 rows)\n",
+              "float parameter after an int one");
+
+        // the same text over a table recreated with other columns
+        session.execute("t ~; t = b : float, a : int; t <- 3.5, 3;");
+        check(captured([&] { session.execute(select, {Value(1)}); }) == "b | a\n3.5 | 3\n(1 row)\n",
+              "after the table is recreated");
+        check(session.cacheMisses() == 3, "rebinding parses nothing again");
+    }
+}
+
+int main() {
+    bindings();
+    std::cout << "bindings ok\n";
+    cacheHits();
+    std::cout << "cache hits ok\n";
+    rebinding();
+    std::cout << "rebinding ok\n";
+}
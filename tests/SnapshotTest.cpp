@@ -0,0 +1,180 @@
+// SnapshotTest.cpp
+// g++ -std=c++17 -pthread -Iinclude tests/SnapshotTest.cpp $(ls src/*.cpp | grep -v main.cpp) -o snapshot-test
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "microRDB/Binder.hpp"
+#include "microRDB/Parser.hpp"
+#include "microRDB/Session.hpp"
+
+namespace {
+    void check(bool ok, const std::string& what) {
+        if (!ok) {
+            std::cerr << "SnapshotTest failed: " << what << "\n";
+            exit(1);
+        }
+    }
+
+    // what f prints
+    std::string captured(const std::function<void()>& f) {
+        std::ostringstream output;
+        std::streambuf* previous = std::cout.rdbuf(output.rdbuf());
+        f();
+        std::cout.rdbuf(previous);
+        return output.str();
+    }
+
+    // the row counts of the results in printed output, in order
+    std::vector<size_t> rowCounts(const std::string& printed) {
+        std::vector<size_t> counts;
+        std::istringstream lines(printed);
+        std::string line;
+        while (std::getline(lines, line)) {
+            if (!line.empty() && line[0] == '(') {
+                counts.push_back(std::stoul(line.substr(1)));
+            }
+        }
+        return counts;
+    }
+
+    // a query sees the state the last transaction left, not the one still open
+    void queryDuringTransaction() {
+        Catalog catalog;
+        ExecutionOptions options;
+        options.scriptTransactions = true;
+        Session writer(catalog, options);
+        Session reader(catalog);
+        writer.execute("t = a : int; t <- 1 <- 2;");
+        check(rowCounts(captured([&] { reader.query("t;"); })) == std::vector<size_t>{2}, "query after a commit");
+
+        // the writer holds the statement lock until commit, a query that waited for it would never return
+        Executor transaction(catalog, options);
+        check(transaction.beginTransaction(), "transaction begins");
+        Binder binder(catalog);
+        auto tokens = Lexer().lexViews("t <- 3;");
+        auto statement = Parser(tokens).parse();
+        statement->accept(&binder);
+        transaction.execute(statement->statements[0].get());
+        check(rowCounts(captured([&] { reader.query("t;"); })) == std::vector<size_t>{2}, "query inside a transaction");
+        transaction.commit();
+        check(rowCounts(captured([&] { reader.query("t;"); })) == std::vector<size_t>{3}, "query after the transaction");
+    }
+
+    // every transaction adds a row to both tables, so every query sees as many rows in one as in the other
+    void consistentUnderWrites(const ExecutionOptions& options) {
+        Catalog catalog;
+        ExecutionOptions writerOptions = options;
+        writerOptions.scriptTransactions = true;
+        Session writer(catalog, writerOptions);
+        Session reader(catalog);
+        writer.execute("t = a : int, b : int; u = a : int, b : int;");
+
+        std::atomic<bool> done{false};
+        std::thread writes([&] {
+            auto& statement = writer.prepare("t <- $1, 1; u <- $1, 1; t := b (b + 1) ? a < $1;");
+            for (int i = 0; i < 500; ++i) {
+                writer.execute(statement, {Value(i)});
+            }
+            done = true;
+        });
+
+        size_t queries = 0;
+        size_t last = 0;
+        while (!done) {
+            auto counts = rowCounts(captured([&] { reader.query("t; u;"); }));
+            check(counts.size() == 2 && counts[0] == counts[1], "both tables of one snapshot");
+            check(counts[0] >= last, "snapshots move forward");
+            last = counts[0];
+            ++queries;
+        }
+        writes.join();
+        auto counts = rowCounts(captured([&] { reader.query("t; u;"); }));
+        check(counts == std::vector<size_t>{500, 500}, "the last snapshot");
+        std::cout << "  " << queries << " queries during writes\n";
+    }
+
+    // a query between statements prints what the writer's own query prints, through inserts, deletes, updates
+    // and the rows a view gains and loses
+    void sameRowsAsWriter(const ExecutionOptions& options) {
+        Catalog catalog;
+        Session writer(catalog, options);
+        Session reader(catalog);
+        writer.execute("t = a : int, b : chars 4; v = t ? a > 10;");
+        std::mt19937 random(3);
+        for (int i = 0; i < 400; ++i) {
+            int a = random() % 20;
+            switch (random() % 4) {
+                case 0: writer.execute("t <- $1, \"x\" <- $2, \"y\";", {Value(a), Value(a + 5)}); break;
+                case 1: writer.execute("t ! ? a == $1;", {Value(a)}); break;
+                case 2: writer.execute("t := a (a + 1), b (\"z\") ? a < $1;", {Value(a)}); break;
+                default: writer.execute("t <- $1, \"w\";", {Value(a)}); break;
+            }
+            // every few statements, so snapshots apply the changes of several publishes
+            if (random() % 3 != 0) {
+                continue;
+            }
+            for (const auto* query : {"t;", "v;"}) {
+                check(captured([&] { reader.query(query); }) == captured([&] { writer.execute(query); }),
+                      std::string("rows of ") + query + " after statement " + std::to_string(i));
+            }
+        }
+    }
+
+    // single row inserts keep their cost while a reader is open, snapshots do not copy the table for each statement
+    void insertsWithReader() {
+        Catalog catalog;
+        Session writer(catalog);
+        Session reader(catalog);
+        writer.execute("t = a : int, b : int;");
+        auto& bulk = writer.prepare("t <- $1, 1 <- $1, 2 <- $1, 3 <- $1, 4 <- $1, 5 <- $1, 6 <- $1, 7 <- $1, 8;");
+        for (int i = 0; i < 25000; ++i) {
+            writer.execute(bulk, {Value(i)});
+        }
+
+        auto& insert = writer.prepare("t <- $1, 0;");
+        auto seconds = [&] {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < 500; ++i) {
+                writer.execute(insert, {Value(i)});
+            }
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+        double alone = seconds();
+        check(rowCounts(captured([&] { reader.query("t;"); })) == std::vector<size_t>{200500}, "rows before the reader");
+        double read = seconds();
+        check(rowCounts(captured([&] { reader.query("t;"); })) == std::vector<size_t>{201000}, "rows after the inserts");
+        std::cout << "  500 inserts into 200k rows: " << alone << " s, " << read << " s with a reader\n";
+        check(read < 10 * alone + 0.05, "inserts with a reader open");
+    }
+}
+
+int main() {
+    queryDuringTransaction();
+    std::cout << "query during transaction ok\n";
+
+    consistentUnderWrites(ExecutionOptions());
+    std::cout << "consistent under writes ok\n";
+
+    ExecutionOptions lsm;
+    lsm.lsmPath = "/tmp/microRDB-snapshot-test";
+    consistentUnderWrites(lsm);
+    std::cout << "consistent under writes to LSM tables ok\n";
+
+    sameRowsAsWriter(ExecutionOptions());
+    std::cout << "same rows as the writer ok\n";
+
+    ExecutionOptions eager;
+    eager.deferCreates = false;
+    sameRowsAsWriter(eager);
+    std::cout << "same rows as the writer with a maintained view ok\n";
+
+    insertsWithReader();
+    std::cout << "inserts with a reader ok\n";
+}
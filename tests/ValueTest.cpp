@@ -0,0 +1,62 @@
+// ValueTest.cpp
+// g++ -std=c++17 -pthread -Iinclude tests/ValueTest.cpp $(ls src/*.cpp | grep -v main.cpp) -o value-test
+
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "microRDB/Session.hpp"
+
+namespace {
+    void check(bool ok, const std::string& what) {
+        if (!ok) {
+            std::cerr << "ValueTest failed: " << what << "\n";
+            exit(1);
+        }
+    }
+
+    // what f prints
+    std::string captured(const std::function<void()>& f) {
+        std::ostringstream output;
+        std::streambuf* previous = std::cout.rdbuf(output.rdbuf());
+        f();
+        std::cout.rdbuf(previous);
+        return output.str();
+    }
+
+    // values that compare equal hash equal
+    void equalHashes() {
+        check(Value(0.0f) == Value(-0.0f), "signed zeros are equal");
+        check(Value(0.0f).hash() == Value(-0.0f).hash(), "signed zeros hash equal");
+        check(Value(std::nanf("")).hash() == Value(-std::nanf("1")).hash(), "every nan hashes equal");
+        check(Value(0.0f).hash() != Value(0).hash(), "a float zero and an int zero hash apart");
+    }
+
+    // hash joins, intersections and point lookups match 0.0 with -0.0
+    void signedZeros(const ExecutionOptions& options) {
+        Catalog catalog;
+        Session session(catalog, options);
+        session.execute("l = x : float, a : int; r = x : float, b : int;");
+        session.execute("l <- $1, 1 <- 1.5, 2;", {Value(0.0f)});
+        session.execute("r <- $1, 3 <- 1.5, 4;", {Value(-0.0f)});
+        check(captured([&] { session.execute("(l ^ r) -> a, b;"); }) == "a | b\n1 | 3\n2 | 4\n(2 rows)\n", "join");
+        check(captured([&] { session.execute("(l -> x) & (r -> x);"); }).find("(2 rows)") != std::string::npos,
+              "intersect");
+        check(captured([&] { session.execute("(l ? x == $1) -> a;", {Value(-0.0f)}); }) == "a\n1\n(1 row)\n",
+              "select");
+    }
+}
+
+int main() {
+    equalHashes();
+    std::cout << "equal hashes ok\n";
+    signedZeros(ExecutionOptions());
+    std::cout << "signed zeros ok\n";
+
+    // the select is a point lookup on an LSM table
+    ExecutionOptions lsm;
+    lsm.lsmPath = "/tmp/microRDB-value-test";
+    signedZeros(lsm);
+    std::cout << "signed zeros in LSM tables ok\n";
+}